@@ -30,34 +30,22 @@ void application(hal::mpu::hardware_map& p_map)
   hal::print(console, "MPU6050 Application Starting...\n");
   hal::mpu::mpu6050 mpu(i2c, 0x68);
 
-  while (true) {
-    hal::print(
-      console,
-      "Setting acceleration max scale to 2g (2 earth gravities)... \n");
-
-    mpu.configure_full_scale(hal::mpu::mpu6050::max_acceleration::g2);
+  hal::print(console,
+             "Enabling automatic full scale ranging starting at 2g... \n");
+  mpu.configure_full_scale(hal::mpu::mpu6050::max_acceleration::g2);
+  mpu.enable_auto_range();
 
-    hal::print(console, "Reading acceleration... \n");
-    auto acceleration = mpu.read();
+  while (true) {
+    auto sample = mpu.read_raw();
+    auto acceleration = hal::mpu::to_read_t(sample);
 
-    hal::print<64>(console,
-                   "Scale: 2g \t x = %fg, y = %fg, z = %fg \n",
+    hal::print<96>(console,
+                   "Scale: %dg \t x = %fg, y = %fg, z = %fg \n",
+                   static_cast<int>(hal::mpu::full_scale_g(sample.gscale)),
                    acceleration.x,
                    acceleration.y,
                    acceleration.z);
 
     hal::delay(clock, 500ms);
-
-    hal::print(
-      console,
-      "Setting acceleration max scale to 4g (4 earth gravities)... \n");
-
-    mpu.configure_full_scale(hal::mpu::mpu6050::max_acceleration::g4);
-    acceleration = mpu.read();
-    hal::print<64>(console,
-                   "Scale: 4g \t x = %fg, y = %fg, z = %fg \n\n",
-                   acceleration.x,
-                   acceleration.y,
-                   acceleration.z);
   }
 }
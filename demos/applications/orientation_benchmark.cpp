@@ -0,0 +1,108 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#include <libhal-mpu/mpu6050.hpp>
+#include <libhal-mpu/orientation.hpp>
+#include <libhal-util/serial.hpp>
+#include <libhal-util/steady_clock.hpp>
+
+#include "../hardware_map.hpp"
+
+namespace {
+// Keeps the compiler from removing the computations being measured
+volatile std::int32_t fixed_sink = 0;
+volatile float float_sink = 0.0f;
+
+hal::mpu::tilt_t float_tilt(const hal::mpu::raw_acceleration& p_sample)
+{
+  constexpr float to_degrees = 180.0f / std::numbers::pi_v<float>;
+  const auto reading = hal::mpu::to_read_t(p_sample);
+  const auto roll = std::atan2(reading.y, reading.z);
+  const auto pitch = std::atan2(
+    -reading.x, std::sqrt(reading.y * reading.y + reading.z * reading.z));
+  return {
+    .pitch = static_cast<hal::mpu::fixed_angle>(pitch * to_degrees *
+                                                hal::mpu::fixed_degree),
+    .roll = static_cast<hal::mpu::fixed_angle>(roll * to_degrees *
+                                               hal::mpu::fixed_degree),
+  };
+}
+}  // namespace
+
+void application(hal::mpu::hardware_map& p_map)
+{
+  using namespace std::chrono_literals;
+  using namespace hal::literals;
+
+  auto& clock = *p_map.clock;
+  auto& console = *p_map.console;
+  auto& i2c = *p_map.i2c;
+
+  hal::print(console, "Orientation Benchmark Starting...\n");
+  hal::mpu::mpu6050 mpu(i2c);
+
+  // Capture real samples up front so that bus time is not measured
+  std::array<hal::mpu::raw_acceleration, 64> samples{};
+  std::array<hal::mpu::raw_rotation, 64> rotations{};
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    samples[i] = mpu.read_raw();
+    rotations[i] = mpu.read_raw_rotation();
+    hal::delay(clock, 1ms);
+  }
+
+  constexpr std::size_t rounds = 100;
+  constexpr auto total_samples = rounds * samples.size();
+
+  while (true) {
+    auto start = clock.uptime();
+    for (std::size_t round = 0; round < rounds; round++) {
+      for (const auto& sample : samples) {
+        fixed_sink = hal::mpu::tilt(sample).pitch;
+      }
+    }
+    const auto fixed_ticks = clock.uptime() - start;
+
+    start = clock.uptime();
+    for (std::size_t round = 0; round < rounds; round++) {
+      for (const auto& sample : samples) {
+        float_sink = static_cast<float>(float_tilt(sample).pitch);
+      }
+    }
+    const auto float_ticks = clock.uptime() - start;
+
+    hal::mpu::complementary_filter filter({});
+    start = clock.uptime();
+    for (std::size_t round = 0; round < rounds; round++) {
+      for (std::size_t i = 0; i < samples.size(); i++) {
+        fixed_sink = filter.update(samples[i], rotations[i], 1000).roll;
+      }
+    }
+    const auto filter_ticks = clock.uptime() - start;
+
+    hal::print<128>(console,
+                    "Clock: %f Hz, ticks per sample: "
+                    "fixed tilt = %lu, float tilt = %lu, "
+                    "fixed fusion = %lu\n",
+                    clock.frequency(),
+                    static_cast<unsigned long>(fixed_ticks / total_samples),
+                    static_cast<unsigned long>(float_ticks / total_samples),
+                    static_cast<unsigned long>(filter_ticks / total_samples));
+
+    hal::delay(clock, 1000ms);
+  }
+}
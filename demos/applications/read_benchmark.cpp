@@ -0,0 +1,102 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <span>
+
+#include <libhal-mpu/mpu6050.hpp>
+#include <libhal-util/serial.hpp>
+#include <libhal-util/steady_clock.hpp>
+
+#include "../hardware_map.hpp"
+
+namespace {
+// Keeps the compiler from removing the reads being measured
+volatile float float_sink = 0.0f;
+volatile std::int16_t raw_sink = 0;
+
+/**
+ * @brief An I2C bus that answers instantly from memory
+ *
+ * Measuring against a real bus would bury the cost of the driver under the
+ * time spent on the wire, so this bus answers every read with the MPU6050's
+ * ID followed by a fixed sample.
+ */
+class memory_i2c : public hal::i2c
+{
+private:
+  void driver_configure(const settings&) override
+  {
+  }
+
+  void driver_transaction(hal::byte,
+                          std::span<const hal::byte>,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    constexpr std::array<hal::byte, 6> response{ 0x68, 0x12, 0x00,
+                                                 0x34, 0x40, 0x00 };
+    std::copy_n(response.begin(),
+                std::min(p_data_in.size(), response.size()),
+                p_data_in.begin());
+  }
+};
+}  // namespace
+
+void application(hal::mpu::hardware_map& p_map)
+{
+  using namespace std::chrono_literals;
+  using namespace hal::literals;
+
+  auto& clock = *p_map.clock;
+  auto& console = *p_map.console;
+
+  hal::print(console, "Read Path Benchmark Starting...\n");
+
+  memory_i2c bus;
+  hal::mpu::mpu6050 mpu(bus);
+  hal::accelerometer& generic = mpu;
+
+  constexpr std::size_t iterations = 10'000;
+
+  while (true) {
+    auto start = clock.uptime();
+    for (std::size_t i = 0; i < iterations; i++) {
+      float_sink = generic.read().x;
+    }
+    const auto virtual_ticks = clock.uptime() - start;
+
+    start = clock.uptime();
+    for (std::size_t i = 0; i < iterations; i++) {
+      float_sink = hal::mpu::to_read_t(mpu.read_raw()).x;
+    }
+    const auto direct_ticks = clock.uptime() - start;
+
+    start = clock.uptime();
+    for (std::size_t i = 0; i < iterations; i++) {
+      raw_sink = mpu.read_raw().x;
+    }
+    const auto raw_ticks = clock.uptime() - start;
+
+    hal::print<128>(console,
+                    "Clock: %f Hz, ticks per read: "
+                    "hal::accelerometer = %lu, inline = %lu, raw = %lu\n",
+                    clock.frequency(),
+                    static_cast<unsigned long>(virtual_ticks / iterations),
+                    static_cast<unsigned long>(direct_ticks / iterations),
+                    static_cast<unsigned long>(raw_ticks / iterations));
+
+    hal::delay(clock, 1000ms);
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+#include <libhal/units.hpp>
+
+namespace hal::mpu {
+/**
+ * @brief Picks the most precise full scale that does not clip the signal
+ *
+ * The range is stepped up as soon as any axis of a sample gets close to
+ * saturating, and stepped down only after a run of samples that would all fit
+ * comfortably within the next smaller range. Stepping down halves the range
+ * and thus doubles the counts, so the lower threshold must be well below half
+ * of the upper threshold for the two decisions to not fight each other.
+ *
+ * This class only makes decisions, it does not talk to any device. Drivers
+ * feed it each raw sample and apply the full scale code it returns.
+ */
+class auto_range
+{
+public:
+  struct settings
+  {
+    /// Step up the range when the magnitude of any axis reaches this count.
+    /// The default is ~94% of the full scale.
+    std::int16_t upper_threshold = 30720;
+    /// Step down the range once every axis stays below this count. The
+    /// default is ~37% of the full scale which lands at ~75% after stepping
+    /// down.
+    std::int16_t lower_threshold = 12288;
+    /// Number of consecutive samples under the lower threshold required
+    /// before the range is stepped down.
+    std::uint16_t hold_samples = 16;
+    /// The smallest full scale code that may be selected (0 = ±2g)
+    hal::byte minimum_gscale = 0;
+    /// The largest full scale code that may be selected (3 = ±16g)
+    hal::byte maximum_gscale = 3;
+  };
+
+  /**
+   * @brief Construct a new auto range decision engine
+   *
+   * @param p_settings - thresholds and limits to use
+   * @param p_gscale - full scale code the device is currently set to
+   * @throws hal::argument_out_of_domain - when the lower threshold is not
+   * below half of the upper threshold or the minimum and maximum full scale
+   * codes are out of order or out of range.
+   */
+  explicit auto_range(settings p_settings, hal::byte p_gscale = 0);
+
+  /**
+   * @brief Feed a sample in and get the full scale to use from now on
+   *
+   * @param p_sample - the latest sample read from the device
+   * @return hal::byte - full scale code that should be used for upcoming
+   * samples. Equal to `gscale()` from before the call if no change is needed.
+   */
+  hal::byte update(const raw_acceleration& p_sample);
+
+  /**
+   * @brief The full scale code currently selected
+   *
+   * @return hal::byte - full scale code from 0 (±2g) to 3 (±16g)
+   */
+  [[nodiscard]] hal::byte gscale() const
+  {
+    return m_gscale;
+  }
+
+  /**
+   * @brief Inform the engine that the full scale was changed outside of it
+   *
+   * @param p_gscale - full scale code the device is now set to
+   */
+  void gscale(hal::byte p_gscale);
+
+private:
+  settings m_settings;
+  /// Samples in a row that could have fit in the next smaller range
+  std::uint16_t m_quiet_samples = 0;
+  hal::byte m_gscale;
+};
+}  // namespace hal::mpu
@@ -0,0 +1,163 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+
+namespace hal::mpu {
+/**
+ * @brief Only lets samples through when the acceleration has changed
+ *
+ * Each sample is compared against the last one that was reported, not the
+ * one right before it, so a slow drift is reported once it adds up to more
+ * than the threshold. The comparison is done on the raw counts, converted to
+ * the ±2g full scale so that a change of full scale alone is not reported.
+ *
+ * This class does not talk to any device. Feed it the samples read from a
+ * driver and only pass on the ones it reports, so that downstream processing
+ * costs nothing while the device sits still.
+ */
+class deadband
+{
+public:
+  struct settings
+  {
+    /// Report a sample when any axis has changed by more than this many
+    /// counts at the ±2g full scale, 16384 per g. The default is ~5mg.
+    std::uint16_t threshold = 82;
+    /// Report a sample once this many samples in a row were suppressed, even
+    /// if nothing changed, so that consumers can tell an idle device from a
+    /// stalled one. 0 suppresses for as long as nothing changes.
+    std::uint32_t max_interval = 0;
+  };
+
+  /**
+   * @brief Construct a new deadband
+   *
+   * @param p_settings - threshold and interval to use
+   */
+  explicit deadband(settings p_settings)
+    : m_settings(p_settings)
+  {
+  }
+
+  /**
+   * @brief Feed a sample in and find out if it should be reported
+   *
+   * The first sample, and the first after `reset()`, is always reported.
+   *
+   * @param p_sample - the latest sample read from the device
+   * @return true - the sample should be reported and is now the one later
+   * samples are compared against
+   * @return false - the sample was suppressed
+   */
+  [[nodiscard]] bool update(const raw_acceleration& p_sample)
+  {
+    const bool interval_elapsed = m_settings.max_interval != 0 &&
+                                  m_since_report >= m_settings.max_interval;
+
+    if (m_has_reported && !interval_elapsed && !changed(p_sample)) {
+      m_since_report++;
+      m_suppressed++;
+      return false;
+    }
+
+    m_last = p_sample;
+    m_since_report = 0;
+    m_has_reported = true;
+    return true;
+  }
+
+  /**
+   * @brief Feed a batch of samples in, such as from a FIFO read
+   *
+   * Reported samples are moved, in order, to the front of the span.
+   *
+   * @param p_samples - samples in the order they were captured
+   * @return std::span<raw_acceleration> - the front of `p_samples` holding
+   * only the reported samples
+   */
+  std::span<raw_acceleration> filter(std::span<raw_acceleration> p_samples)
+  {
+    std::size_t reported = 0;
+    for (const auto& sample : p_samples) {
+      if (update(sample)) {
+        p_samples[reported++] = sample;
+      }
+    }
+    return p_samples.first(reported);
+  }
+
+  /**
+   * @brief The sample that was reported last
+   *
+   * @return const raw_acceleration& - last reported sample, all zeros before
+   * the first report
+   */
+  [[nodiscard]] const raw_acceleration& last_reported() const
+  {
+    return m_last;
+  }
+
+  /**
+   * @brief Number of samples suppressed since construction or `reset()`
+   *
+   * @return std::uint32_t - suppressed sample count, wraps around on overflow
+   */
+  [[nodiscard]] std::uint32_t suppressed() const
+  {
+    return m_suppressed;
+  }
+
+  /**
+   * @brief Forget the last reported sample and clear the counters
+   *
+   * Call this after reconfiguring the device so that the next sample is
+   * reported regardless of how it compares to the previous ones.
+   */
+  void reset()
+  {
+    m_last = {};
+    m_since_report = 0;
+    m_suppressed = 0;
+    m_has_reported = false;
+  }
+
+private:
+  bool changed(const raw_acceleration& p_sample) const
+  {
+    auto moved = [this, &p_sample](std::int16_t p_now, std::int16_t p_then) {
+      const auto delta =
+        normalize(p_now, p_sample.gscale) - normalize(p_then, m_last.gscale);
+      return std::abs(delta) > m_settings.threshold;
+    };
+
+    return moved(p_sample.x, m_last.x) || moved(p_sample.y, m_last.y) ||
+           moved(p_sample.z, m_last.z);
+  }
+
+  settings m_settings;
+  raw_acceleration m_last{};
+  /// Samples suppressed since the last report
+  std::uint32_t m_since_report = 0;
+  std::uint32_t m_suppressed = 0;
+  bool m_has_reported = false;
+};
+}  // namespace hal::mpu
@@ -14,15 +14,29 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
+#include <span>
+
+#include <libhal-mpu/lis_traits.hpp>
+#include <libhal-mpu/raw_acceleration.hpp>
 #include <libhal-util/bit.hpp>
 #include <libhal-util/i2c.hpp>
 #include <libhal-util/map.hpp>
-#include <libhal-util/steady_clock.hpp>
 #include <libhal/accelerometer.hpp>
-#include <libhal/serial.hpp>
 
 namespace hal::mpu {
-class lis3dhtr : public hal::accelerometer
+/**
+ * @brief Driver for the LIS3DH family of accelerometers
+ *
+ * The register map and event scaling come from `Traits`, see `basic_mpu` for
+ * the same arrangement. Use the `lis3dhtr` and `lis2dh12` aliases.
+ *
+ * @tparam Traits - register map and scaling of the part, such as
+ * `lis3dh_traits`
+ */
+template<class Traits>
+class basic_lis final : public hal::accelerometer
 {
 
   // send slave address first, then sub address is sent
@@ -33,6 +47,8 @@ public:
   static constexpr hal::byte low_address = 0b0001'1000;
   /// The device address when SDO/SA0 is connected to 3v3.
   static constexpr hal::byte high_address = 0b0001'1001;
+  /// Number of bytes making up one X, Y, Z sample
+  static constexpr std::size_t bytes_per_sample = 6;
 
   enum class max_acceleration : hal::byte
   {
@@ -75,99 +91,203 @@ public:
     mode_9 = 0b1001,
   };
 
-  enum class fifo_mode_configs : hal::byte
+  /// Detects acceleration changes, such as the device being picked up or
+  /// bumped. Uses inertial interrupt generator 1 on high pass filtered data so
+  /// gravity does not count.
+  struct motion_settings
   {
-    /// 2x the average earth gravity of acceleration
-    /// this is the default
-    bypass = 0x00,
-    /// 4x the average earth gravity of acceleration
-    fifo = 0x01,
-    /// 8x the average earth gravity of acceleration
-    stream_mode = 0x02,
-    /// 16x the average earth gravity of acceleration
-    stream_to_fifo = 0x03,
+    /// Change in acceleration, in g, that counts as motion. The resolution
+    /// depends on the full scale: 16mg at 2g, 32mg at 4g, 62mg at 8g and
+    /// 186mg at 16g, up to 127 steps.
+    float threshold = 0.1f;
+    /// Number of samples, at the configured data rate, that the threshold
+    /// must be exceeded for. Up to 127.
+    hal::byte duration = 0;
   };
 
-  /**
-   * @brief Constructs and returns lis object
-   *
-   * @param p_i2c - I2C bus the lis is connected to
-   * @param p_device_address - address of the lis3dhtr
-   * @return lis3dhtr object
-   * @throws std::errc::invalid_byte_sequence - when ID register does not match
-   * the expected ID for the lis3dhtr device.
-   */
-  static result<lis3dhtr> create(hal::i2c& p_i2c,
-                                 hal::serial& p_console,
-                                 hal::steady_clock* clock,
-                                 hal::byte p_device_address = low_address);
+  /// Detects all three axes reading close to 0g, which is what an
+  /// accelerometer in free fall experiences. Uses inertial interrupt
+  /// generator 2 on unfiltered data.
+  struct free_fall_settings
+  {
+    /// Every axis must be below this acceleration, in g, to count as free
+    /// fall. Same resolution as `motion_settings::threshold`.
+    float threshold = 0.35f;
+    /// Number of samples, at the configured data rate, that free fall must
+    /// last for. Up to 127.
+    hal::byte duration = 3;
+  };
+
+  /// Detects single or double taps on any axis using the click engine.
+  struct click_settings
+  {
+    /// Acceleration, in g, a tap must exceed. Same resolution as
+    /// `motion_settings::threshold`.
+    float threshold = 0.5f;
+    /// Samples the acceleration may stay above the threshold for to still
+    /// count as a tap. Up to 127.
+    hal::byte time_limit = 10;
+    /// Samples after the first tap during which a second tap is ignored.
+    hal::byte time_latency = 20;
+    /// Samples after the latency during which a second tap must start to
+    /// count as a double tap.
+    hal::byte time_window = 50;
+    /// Detect double taps instead of single taps
+    bool double_click = false;
+  };
 
-  hal::status toggle_off_continuous_update(hal::steady_clock* clock);
+  struct event_settings
+  {
+    /// Motion detection, disabled when empty
+    std::optional<motion_settings> motion;
+    /// Free fall detection, disabled when empty
+    std::optional<free_fall_settings> free_fall;
+    /// Tap detection, disabled when empty
+    std::optional<click_settings> click;
+    /// Hold the INT1 pin asserted until `read_events()` is called
+    bool latch = true;
+    /// The INT1 pin idles high and is pulled low on an event
+    bool active_low = false;
+  };
 
-  hal::status read_test(hal::serial& p_console);
+  /// Events reported by the device since the last call to `read_events()`
+  struct events_t
+  {
+    bool motion = false;
+    bool free_fall = false;
+    bool click = false;
+    bool double_click = false;
+    /// Axes that triggered the last motion event, only filled in when `motion`
+    /// is set.
+    bool motion_x = false;
+    bool motion_y = false;
+    bool motion_z = false;
+  };
 
   /**
-   * @brief Re-enables acceleration readings from the lis
+   * @brief Construct a LIS driver and power on the device
    *
-   * @return hal::status - success or errors from i2c communication
-   * @throws std::errc::invalid_byte_sequence - when ID register does not match
-   * the expected ID for the lis3dhtr device.
+   * @param p_i2c - I2C bus the device is connected to
+   * @param p_device_address - address of the device
+   * @throws hal::no_such_device - when the ID register does not match
+   * `Traits::device_id`.
    */
-  [[nodiscard]] hal::status power_on(hal::serial& p_console,
-                                     hal::steady_clock* clock);
+  explicit basic_lis(hal::i2c& p_i2c,
+                     hal::byte p_device_address = low_address);
 
   /**
-   * @brief Disables acceleration reading from the lis3dhtr.
-   *
-   * @return hal::status - success or errors from i2c communication
+   * @brief Re-enables acceleration readings at 400Hz
    */
-  [[nodiscard]] hal::status power_off(hal::serial& p_console,
-                                      hal::steady_clock* clock);
-
-  [[nodiscard]] hal::status configure_data_rates(data_rate_configs p_data_rate,
-                                                 hal::serial& p_console,
-                                                 hal::steady_clock* clock);
+  void power_on();
 
-  [[nodiscard]] hal::status configure_ctrl_reg4(hal::serial& p_console);
+  /**
+   * @brief Disables acceleration reading from the device.
+   */
+  void power_off();
 
-  [[nodiscard]] hal::status set_normal_mode(hal::steady_clock* clock);
+  /**
+   * @brief Set the output data rate
+   *
+   * @param p_data_rate - data rate, `data_rate_configs::mode_0` powers the
+   * device down.
+   */
+  void configure_data_rates(data_rate_configs p_data_rate);
 
   /**
    * @brief Changes the gravity scale that the lis is reading. The larger the
    * scale, the less precise the reading.
    *
    * @param p_gravity_code - Scales in powers of 2 up to 16.
-   * @return hal::status - success or errors from i2c communication
    */
-  [[nodiscard]] hal::status configure_full_scale(
-    max_acceleration p_gravity_code,
-    hal::steady_clock* clock);
+  void configure_full_scale(max_acceleration p_gravity_code);
 
-  [[nodiscard]] hal::status toggle_fifo(bool p_toggle,
-                                        hal::steady_clock* clock);
+  /**
+   * @brief Configure which events the device detects and signals on INT1
+   *
+   * Letting the device watch for events allows the host to sleep until the
+   * INT1 pin is asserted, instead of polling `read()`. Thresholds are
+   * converted using the current full scale, so call this after
+   * `configure_full_scale()`.
+   *
+   * @param p_settings - events to detect and how INT1 is driven
+   * @throws hal::argument_out_of_domain - when a threshold or duration is
+   * outside of what the device supports.
+   */
+  void configure_events(const event_settings& p_settings);
 
-  [[nodiscard]] hal::status configure_fifo_mode(fifo_mode_configs p_toggle,
-                                                hal::steady_clock* clock);
+  /**
+   * @brief Read and clear the events that have occurred
+   *
+   * All event sources are read in a single burst transaction.
+   *
+   * @return events_t - events since the last call
+   */
+  events_t read_events();
 
-  [[nodiscard]] hal::status reboot_memory_content(hal::steady_clock* clock);
+  /**
+   * @brief Read acceleration without converting it to floating point
+   *
+   * This is the fast path for tight sampling loops. It is defined in this
+   * header and does not go through the virtual `hal::accelerometer`
+   * interface, so the decode can be inlined into the caller. Use
+   * `to_read_t()` on the result when a value in g is needed.
+   *
+   * @return raw_acceleration - acceleration counts tagged with the full scale
+   * they were captured at.
+   */
+  raw_acceleration read_raw()
+  {
+    std::array<hal::byte, bytes_per_sample> xyz_acceleration;
+    hal::write_then_read(*m_i2c,
+                         m_address,
+                         std::array{ acceleration_output_register },
+                         xyz_acceleration,
+                         hal::never_timeout());
+    return decode(xyz_acceleration, m_gscale);
+  }
 
-private:
   /**
-   * @brief lis3dhtr Constructor
+   * @brief Decode the output registers of one sample into counts
    *
-   * @param p_i2c - i2c peripheral used to commnicate with device.
-   * @param p_address - lis3dhtr device address.
+   * All data is left justified, low byte first. The unused low bits read as
+   * 0, so ORing the low and high bytes together gives a signed 16-bit value
+   * over the whole full scale, whatever the resolution mode.
+   *
+   * @param p_data - the six output bytes, X low byte first
+   * @param p_gscale - full scale code the bytes were captured at
+   * @return raw_acceleration - decoded sample
    */
-  lis3dhtr(i2c& p_i2c, hal::byte p_device_address);
+  static constexpr raw_acceleration decode(
+    std::span<const hal::byte, bytes_per_sample> p_data,
+    hal::byte p_gscale)
+  {
+    return {
+      .x = static_cast<std::int16_t>(p_data[0] | p_data[1] << 8),
+      .y = static_cast<std::int16_t>(p_data[2] | p_data[3] << 8),
+      .z = static_cast<std::int16_t>(p_data[4] | p_data[5] << 8),
+      .gscale = p_gscale,
+    };
+  }
 
-  hal::result<accelerometer::read_t> driver_read() override;
+private:
+  /// OUT_X_L with the auto increment bit set, so that all axes are read in
+  /// one transaction.
+  static constexpr hal::byte acceleration_output_register =
+    Traits::out_x_l | Traits::auto_increment;
+
+  accelerometer::read_t driver_read() override;
 
   /// The I2C peripheral used for communication with the device.
   hal::i2c* m_i2c;
   /// The configurable device address used for communication.
   hal::byte m_address;
   /// The minimum and maxium g's that the device will read
-  hal::byte m_gscale;
+  hal::byte m_gscale = 0;
 };
 
+using lis3dhtr = basic_lis<lis3dh_traits>;
+using lis2dh12 = basic_lis<lis2dh12_traits>;
+
+extern template class basic_lis<lis3dh_traits>;
+extern template class basic_lis<lis2dh12_traits>;
 }  // namespace hal::mpu
@@ -0,0 +1,90 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+
+#include <libhal/units.hpp>
+
+namespace hal::mpu {
+/// Registers shared by the LIS3DH family of accelerometers
+struct lis_register_map
+{
+  /// Device identification register
+  static constexpr hal::byte who_am_i_register = 0x0F;
+  /// Used to set data rate selection, power mode, and z, y, and x axis
+  /// toggling
+  static constexpr hal::byte ctrl_reg1 = 0x20;
+  /// Used to configure the high pass filter and what it is applied to
+  static constexpr hal::byte ctrl_reg2 = 0x21;
+  /// Used to route interrupt sources to the INT1 pin
+  static constexpr hal::byte ctrl_reg3 = 0x22;
+  /// Used to set the full scale and resolution
+  static constexpr hal::byte ctrl_reg4 = 0x23;
+  /// Used to reboot memory, toggle the fifo and latch interrupts
+  static constexpr hal::byte ctrl_reg5 = 0x24;
+  /// Used to set INT pin polarity
+  static constexpr hal::byte ctrl_reg6 = 0x25;
+  /// Reading this register resets the high pass filter to the current
+  /// acceleration
+  static constexpr hal::byte reference_reg = 0x26;
+  /// Low byte of the X axis output, followed by the other output bytes
+  static constexpr hal::byte out_x_l = 0x28;
+  /// Used to change fifo modes
+  static constexpr hal::byte fifo_ctrl_reg = 0x2E;
+
+  /// Inertial interrupt generator 1 configuration, source, threshold and
+  /// duration
+  static constexpr hal::byte int1_cfg = 0x30;
+  static constexpr hal::byte int1_src = 0x31;
+  static constexpr hal::byte int1_ths = 0x32;
+  static constexpr hal::byte int1_duration = 0x33;
+  /// Inertial interrupt generator 2 configuration, source, threshold and
+  /// duration
+  static constexpr hal::byte int2_cfg = 0x34;
+  static constexpr hal::byte int2_src = 0x35;
+  static constexpr hal::byte int2_ths = 0x36;
+  static constexpr hal::byte int2_duration = 0x37;
+  /// Click detection configuration, source, threshold and timing
+  static constexpr hal::byte click_cfg = 0x38;
+  static constexpr hal::byte click_src = 0x39;
+  static constexpr hal::byte click_ths = 0x3A;
+  static constexpr hal::byte time_limit = 0x3B;
+  static constexpr hal::byte time_latency = 0x3C;
+  static constexpr hal::byte time_window = 0x3D;
+
+  /// Setting the MSb of a register address makes multi-byte transfers
+  /// increment through registers
+  static constexpr hal::byte auto_increment = 0x80;
+};
+
+/// LIS3DH accelerometer, including the LIS3DHTR package
+struct lis3dh_traits : lis_register_map
+{
+  /// Value of the WHO_AM_I register
+  static constexpr hal::byte device_id = 0x33;
+  /// Acceleration represented by one LSB of the event thresholds, in g, for
+  /// each full scale from 2g through 16g.
+  static constexpr std::array<float, 4> event_g_per_lsb{
+    0.016f, 0.032f, 0.062f, 0.186f
+  };
+};
+
+/// LIS2DH12 accelerometer. It shares the register map, event threshold
+/// scaling and WHO_AM_I value of the LIS3DH, so the two cannot be told apart
+/// by probing, and either driver works with either part.
+struct lis2dh12_traits : lis3dh_traits
+{};
+}  // namespace hal::mpu
@@ -14,19 +14,51 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include <libhal-mpu/auto_range.hpp>
+#include <libhal-mpu/mpu_traits.hpp>
+#include <libhal-mpu/raw_acceleration.hpp>
+#include <libhal-mpu/raw_rotation.hpp>
+#include <libhal-mpu/temperature_compensation.hpp>
 #include <libhal-util/bit.hpp>
 #include <libhal-util/i2c.hpp>
 #include <libhal-util/map.hpp>
 #include <libhal/accelerometer.hpp>
+#include <libhal/units.hpp>
 
 namespace hal::mpu {
-class mpu6050 : public hal::accelerometer
+/**
+ * @brief Driver for the MPU family of accelerometers and gyroscopes
+ *
+ * The register map and the differences between parts come from `Traits`, so
+ * each part gets its own read path with the register addresses folded in at
+ * compile time. Use the `mpu6050`, `mpu6500` and `mpu9250` aliases, and
+ * `probe()` to find out which part is connected.
+ *
+ * @tparam Traits - register map and capabilities of the part, such as
+ * `mpu6050_traits`
+ */
+template<class Traits>
+class basic_mpu final : public hal::accelerometer
 {
 public:
   /// The device address when A0 is connected to GND.
   static constexpr hal::byte address_ground = 0b110'1000;
   /// The device address when A0 is connected to V+.
   static constexpr hal::byte address_voltage_high = 0b110'1001;
+  /// Number of bytes making up one X, Y, Z sample
+  static constexpr std::size_t bytes_per_sample = 6;
+  /// Number of whole samples the FIFO holds
+  static constexpr std::size_t fifo_capacity =
+    Traits::fifo_size / bytes_per_sample;
 
   enum class max_acceleration : hal::byte
   {
@@ -40,17 +72,130 @@ public:
     g16 = 0x03,
   };
 
+  /// How often the accelerometer wakes up to capture a sample in cycle mode.
+  /// Rates are those of the MPU6050, parts with a different set of rates use
+  /// the closest one at or above it, see `Traits::cycle_periods`.
+  enum class wake_rate : hal::byte
+  {
+    /// 1.25Hz, ~10uA on the MPU6050
+    hz1_25 = 0x00,
+    /// 5Hz, ~20uA on the MPU6050
+    hz5 = 0x01,
+    /// 20Hz, ~70uA on the MPU6050
+    hz20 = 0x02,
+    /// 40Hz, ~140uA on the MPU6050
+    hz40 = 0x03,
+  };
+
+  /// Which parts of the device are powered. The defaults are the power on
+  /// state, with everything running at ~3.9mA on the MPU6050. Turning the
+  /// gyroscope off leaves the accelerometer running continuously at ~500uA.
+  struct power_profile
+  {
+    /// Keep the gyroscope running, it draws most of the current.
+    bool gyroscope = true;
+    /// Keep the temperature sensor running
+    bool temperature = true;
+    /// Keep the X axis of the accelerometer running
+    bool accelerometer_x = true;
+    /// Keep the Y axis of the accelerometer running
+    bool accelerometer_y = true;
+    /// Keep the Z axis of the accelerometer running
+    bool accelerometer_z = true;
+    /// Sleep between samples, waking up at this rate to capture one
+    /// accelerometer sample. Requires the gyroscope to be off. When empty,
+    /// samples are captured at the rate from `configure_sample_rate()`.
+    std::optional<wake_rate> cycle;
+  };
+
+  /// Detects acceleration changes, such as the device being picked up or
+  /// bumped. Runs on high pass filtered data so gravity does not count. Parts
+  /// with wake on motion compare each sample against the previous one
+  /// instead.
+  struct motion_settings
+  {
+    /// Change in acceleration, in g, that counts as motion. Resolution of
+    /// 2mg up to 0.51g, or 4mg up to 1.02g on parts with wake on motion.
+    float threshold = 0.04f;
+    /// How long the threshold must be exceeded before the event fires.
+    /// Resolution of 1ms up to 255ms. Ignored by parts with wake on motion,
+    /// which fire on the first sample over the threshold.
+    hal::time_duration duration = std::chrono::milliseconds(1);
+  };
+
+  /// Detects all three axes reading close to 0g, which is what an
+  /// accelerometer in free fall experiences.
+  struct free_fall_settings
+  {
+    /// Every axis must be below this acceleration, in g, to count as free
+    /// fall. Resolution of 2mg up to 0.51g.
+    float threshold = 0.3f;
+    /// How long free fall must last before the event fires. Resolution of
+    /// 1ms up to 255ms.
+    hal::time_duration duration = std::chrono::milliseconds(30);
+  };
+
+  struct event_settings
+  {
+    /// Motion detection, disabled when empty
+    std::optional<motion_settings> motion;
+    /// Free fall detection, disabled when empty. Free fall detection is only
+    /// documented in earlier revisions of the MPU6050 register map, and is
+    /// not available on parts with wake on motion. Motion detection needs the
+    /// high pass filter that free fall detection cannot work with, so the two
+    /// cannot be enabled together.
+    std::optional<free_fall_settings> free_fall;
+    /// Assert the INT pin whenever a new sample is available. Also enabled by
+    /// the driver while waiting for the first sample after a full scale
+    /// change.
+    bool data_ready = false;
+    /// Hold the INT pin asserted until `read_events()` is called, rather than
+    /// pulsing it for 50us.
+    bool latch = true;
+    /// The INT pin idles high and is pulled low on an event
+    bool active_low = false;
+  };
+
+  /// Events reported by the device since the last call to `read_events()`
+  struct events_t
+  {
+    bool motion = false;
+    bool free_fall = false;
+    bool data_ready = false;
+    bool fifo_overflow = false;
+    /// Axes that triggered the last motion event, only filled in when `motion`
+    /// is set and the part does not use wake on motion.
+    bool motion_x = false;
+    bool motion_y = false;
+    bool motion_z = false;
+  };
+
+  /**
+   * @brief Construct an MPU driver
+   *
+   * @param p_i2c - the driver for the i2c bus the device is connected to
+   * @param p_address - device address
+   * @throws hal::no_such_device - when an invalid device is detected. MPU
+   * devices have a read-only ID register which allows a microcontroller to
+   * determine what device it is connected to. This register will be read and
+   * if it does not match `Traits::device_id`, this exception is thrown.
+   */
+  explicit basic_mpu(i2c& p_i2c, hal::byte p_address = address_ground);
+
   /**
-   * @brief Construct an mpu6050 driver
+   * @brief Check whether this part is at an address
    *
-   * @param p_i2c - the driver for the i2c bus the MPU6050 is connected to
-   * @param p_address - mpu6050 device address
-   * @throws hal::no_such_device - when an invalid MPU6050 device is detected.
-   * MPU6050 devices have a read-only ID register which allows a microcontroller
-   * to determine what device it is connected to. This register will be read and
-   * if it does not match the expected value, this exception is thrown.
+   * Reads the WHO_AM_I register and compares it against `Traits::device_id`.
+   * Use this to pick which driver to construct when a board may be fitted
+   * with any of the supported parts.
+   *
+   * @param p_i2c - the driver for the i2c bus the device is connected to
+   * @param p_address - device address
+   * @return true - the part answered with the expected ID
+   * @return false - no device acknowledged the address, or it reported a
+   * different ID
    */
-  explicit mpu6050(i2c& p_i2c, hal::byte p_address = address_ground);
+  static bool probe(i2c& p_i2c, hal::byte p_address = address_ground);
 
   /**
    * @brief Changes the gravity scale that the MPU is reading. The larger the
@@ -60,6 +205,381 @@ public:
    */
   void configure_full_scale(max_acceleration p_gravity_code);
 
+  /**
+   * @brief Let the driver pick the full scale based on recent samples
+   *
+   * After every read, the sample is handed to an `auto_range` engine. When the
+   * engine asks for a different full scale, the driver writes the new scale to
+   * the device right away, using a cached copy of the configuration register
+   * so that no extra read is needed. The new scale applies to samples the
+   * device captures after the write; each sample returned by `read_raw()` is
+   * tagged with the scale it was captured at. Until DATA_RDY shows that a
+   * sample was captured at the new scale, reads also fetch INT_STATUS in the
+   * same transaction. Any events cleared by doing so are still reported by
+   * the next `read_events()`. The device only reports DATA_RDY while its
+   * interrupt is enabled, so during that time the INT pin also signals data
+   * ready, even if `configure_events()` did not ask for it.
+   *
+   * Calling `configure_full_scale()` afterwards sets the scale that the
+   * engine continues from.
+   *
+   * @param p_settings - thresholds and limits for the auto range engine
+   * @throws hal::argument_out_of_domain - when the settings are invalid, see
+   * `auto_range::auto_range()`.
+   */
+  void enable_auto_range(auto_range::settings p_settings = {});
+
+  /**
+   * @brief Stop changing the full scale automatically
+   *
+   * The device is left at whichever full scale was last selected.
+   */
+  void disable_auto_range();
+
+  /**
+   * @brief Read acceleration without converting it to floating point
+   *
+   * This is the fast path for tight sampling loops. It is defined in this
+   * header and does not go through the virtual `hal::accelerometer`
+   * interface, so the decode can be inlined into the caller. Use
+   * `to_read_t()` on the result when a value in g is needed.
+   *
+   * @return raw_acceleration - acceleration counts tagged with the full scale
+   * they were captured at.
+   */
+  raw_acceleration read_raw()
+  {
+    std::array<hal::byte, bytes_per_sample> xyz_acceleration;
+    const auto gscale = read_output(xyz_acceleration);
+
+    const auto sample = decode(xyz_acceleration, gscale);
+
+    if (m_auto_range) [[unlikely]] {
+      apply_auto_range(sample);
+    }
+
+    return sample;
+  }
+
+  /**
+   * @brief Read acceleration and die temperature in one transaction
+   *
+   * The temperature registers directly follow the acceleration registers, so
+   * this costs two more bytes on the bus and no extra transactions over
+   * `read_raw()`. Pair it with `temperature_compensation` to remove thermal
+   * bias drift.
+   *
+   * @return thermal_sample - acceleration counts tagged with the full scale
+   * they were captured at, and the die temperature
+   */
+  thermal_sample read_raw_with_temperature()
+  {
+    std::array<hal::byte, bytes_per_sample + 2> data;
+    const auto gscale = read_output(data);
+
+    const thermal_sample sample{
+      .acceleration =
+        decode(std::span(data).template first<bytes_per_sample>(), gscale),
+      .temperature = to_celsius(static_cast<std::int16_t>(
+        data[bytes_per_sample] << 8 | data[bytes_per_sample + 1])),
+    };
+
+    if (m_auto_range) [[unlikely]] {
+      apply_auto_range(sample.acceleration);
+    }
+
+    return sample;
+  }
+
+  /**
+   * @brief Convert a TEMP_OUT reading into degrees Celsius
+   *
+   * @param p_counts - value of TEMP_OUT
+   * @return fixed_celsius - die temperature
+   */
+  static constexpr fixed_celsius to_celsius(std::int16_t p_counts)
+  {
+    // Counts per °C is not a whole number, so the scale carries 8 more
+    // fractional bits than the result and is shifted back down after the
+    // multiply.
+    constexpr auto scale = static_cast<std::int64_t>(
+      (1 << 24) / Traits::temperature_sensitivity + 0.5);
+    constexpr auto offset = static_cast<fixed_celsius>(
+      Traits::temperature_offset * fixed_celsius_degree + 0.5);
+    return static_cast<fixed_celsius>((p_counts * scale) >> 8) + offset;
+  }
+
+  /**
+   * @brief Decode the output registers of one sample into counts
+   *
+   * First X-axis Byte (MSB first)
+   * =========================================================================
+   * Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
+   *  XD15 | XD14  |  XD13 |  XD12 |  XD11 |  XD10 |  XD9  |  XD8
+   *
+   * Final X-axis Byte (LSB)
+   * =========================================================================
+   * Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
+   *   XD7 |   XD6 |   XD5 |   XD4 |   XD3 |   XD2 |   XD1 |   XD0
+   *
+   * We simply shift and OR the bytes together to get them into a signed int
+   * 16 value. Y and Z follow in the same format.
+   *
+   * @param p_data - the six output bytes, X high byte first
+   * @param p_gscale - full scale code the bytes were captured at
+   * @return raw_acceleration - decoded sample
+   */
+  static constexpr raw_acceleration decode(
+    std::span<const hal::byte, bytes_per_sample> p_data,
+    hal::byte p_gscale)
+  {
+    return {
+      .x = static_cast<std::int16_t>(p_data[0] << 8 | p_data[1]),
+      .y = static_cast<std::int16_t>(p_data[2] << 8 | p_data[3]),
+      .z = static_cast<std::int16_t>(p_data[4] << 8 | p_data[5]),
+      .gscale = p_gscale,
+    };
+  }
+
+  /**
+   * @brief Set how often the device captures samples
+   *
+   * Enables the digital low pass filter (184Hz bandwidth), which fixes the
+   * internal rate at 1kHz, and divides that down to the nearest rate
+   * available. Samples are captured at this rate into the output registers
+   * and, when enabled, the FIFO.
+   *
+   * @param p_rate - desired sample rate, from 3.9Hz to 1kHz, rates outside
+   * of this range are clamped to it
+   * @return hal::hertz - the sample rate actually set
+   * @throws hal::argument_out_of_domain - when the rate is not a positive
+   * number.
+   */
+  hal::hertz configure_sample_rate(hal::hertz p_rate);
+
+  /**
+   * @brief Start buffering acceleration samples in the device's FIFO
+   *
+   * The FIFO is emptied first. It holds `fifo_capacity` samples, 170 on the
+   * MPU6050 and 85 on the MPU6500 and MPU9250. Drain it before it fills, the
+   * FIFO size is not a multiple of a sample, so once the oldest data is
+   * overwritten the remaining bytes no longer line up with samples. See
+   * `read_fifo()` for how an overflow is handled.
+   *
+   * While the FIFO is enabled, changing the full scale, directly or through
+   * automatic ranging, empties it. The FIFO does not record the scale of its
+   * frames, so this keeps every buffered frame at the current scale.
+   */
+  void enable_fifo();
+
+  /**
+   * @brief Stop buffering samples in the FIFO
+   */
+  void disable_fifo();
+
+  /**
+   * @brief Number of whole samples waiting in the FIFO
+   *
+   * @return std::size_t - samples available to `read_fifo()`
+   */
+  std::size_t fifo_sample_count();
+
+  /**
+   * @brief Frames read from the FIFO, decoded only when accessed
+   *
+   * A view refers to the caller's buffer and is only valid for as long as
+   * the buffer is. Each access decodes the frame from the buffer, nothing is
+   * copied or cached.
+   */
+  class fifo_view
+  {
+  public:
+    /// Forward iterator yielding decoded samples by value
+    class iterator
+    {
+    public:
+      using iterator_concept = std::forward_iterator_tag;
+      using value_type = raw_acceleration;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+
+      raw_acceleration operator*() const
+      {
+        return decode(m_frame.template first<bytes_per_sample>(), m_gscale);
+      }
+
+      iterator& operator++()
+      {
+        m_frame = m_frame.subspan(bytes_per_sample);
+        return *this;
+      }
+
+      iterator operator++(int)
+      {
+        auto previous = *this;
+        ++*this;
+        return previous;
+      }
+
+      friend bool operator==(const iterator& p_lhs, const iterator& p_rhs)
+      {
+        return p_lhs.m_frame.data() == p_rhs.m_frame.data();
+      }
+
+    private:
+      friend class fifo_view;
+
+      iterator(std::span<const hal::byte> p_frames, hal::byte p_gscale)
+        : m_frame(p_frames)
+        , m_gscale(p_gscale)
+      {
+      }
+
+      /// The frame the iterator points at and every frame after it
+      std::span<const hal::byte> m_frame{};
+      hal::byte m_gscale = 0;
+    };
+
+    fifo_view() = default;
+
+    /**
+     * @brief Construct a view over whole frames
+     *
+     * @param p_frames - frames exactly as read from FIFO_R_W, any trailing
+     * partial frame is left out of the view
+     * @param p_gscale - full scale code the frames were captured at
+     */
+    fifo_view(std::span<const hal::byte> p_frames, hal::byte p_gscale)
+      : m_frames(p_frames.first(p_frames.size() -
+                                p_frames.size() % bytes_per_sample))
+      , m_gscale(p_gscale)
+    {
+    }
+
+    [[nodiscard]] iterator begin() const
+    {
+      return { m_frames, m_gscale };
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+      return { m_frames.last(0), m_gscale };
+    }
+
+    /**
+     * @brief Decode one frame
+     *
+     * @param p_index - frame to decode, must be less than `size()`
+     * @return raw_acceleration - the decoded sample
+     */
+    [[nodiscard]] raw_acceleration operator[](std::size_t p_index) const
+    {
+      return decode(m_frames.subspan(p_index * bytes_per_sample)
+                      .template first<bytes_per_sample>(),
+                    m_gscale);
+    }
+
+    /// Number of frames in the view
+    [[nodiscard]] std::size_t size() const
+    {
+      return m_frames.size() / bytes_per_sample;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+      return m_frames.empty();
+    }
+
+    /// The frames as raw bytes, for storing them without decoding
+    [[nodiscard]] std::span<const hal::byte> bytes() const
+    {
+      return m_frames;
+    }
+
+    /// Full scale code the frames were captured at
+    [[nodiscard]] hal::byte gscale() const
+    {
+      return m_gscale;
+    }
+
+  private:
+    std::span<const hal::byte> m_frames{};
+    hal::byte m_gscale = 0;
+  };
+
+  /**
+   * @brief Drain frames from the FIFO straight into a caller owned buffer
+   *
+   * As many whole frames as are available and fit are read in a single
+   * transaction, with the buffer handed directly to the I2C driver, so a DMA
+   * capable buffer is filled without any intermediate copies. Frames are
+   * decoded only when accessed through the returned view, logging
+   * `fifo_view::bytes()` skips decoding entirely.
+   *
+   * INT_STATUS is checked before draining. If the FIFO overflowed, including
+   * when the overflow was already reported by `read_events()`, its contents
+   * are no longer aligned to frames, so it is reset, discarding them, and an
+   * exception is thrown. Buffering resumes right away, so
+   * calling again returns samples captured after the reset. Any other events
+   * pending in INT_STATUS are still reported by the next `read_events()`.
+   *
+   * @param p_buffer - where to place the frames, oldest first, a multiple of
+   * `bytes_per_sample` in size to avoid wasting space
+   * @return fifo_view - view of the part of `p_buffer` that was filled
+   * @throws hal::io_error - when the FIFO overflowed since it was last read.
+   */
+  fifo_view read_fifo(std::span<hal::byte> p_buffer);
+
+  /**
+   * @brief Drain samples from the FIFO
+   *
+   * Reads as many samples as are available, up to the size of `p_samples`.
+   * Samples are tagged with the current full scale, which all of them were
+   * captured at since a scale change empties the FIFO, see `enable_fifo()`.
+   * Automatic ranging is not applied to FIFO data. Overflows are handled as
+   * by the byte buffer overload.
+   *
+   * @param p_samples - where to place the samples, oldest first
+   * @return std::span<raw_acceleration> - the part of `p_samples` that was
+   * filled
+   * @throws hal::io_error - when the FIFO overflowed since it was last read.
+   */
+  std::span<raw_acceleration> read_fifo(std::span<raw_acceleration> p_samples);
+
+  /**
+   * @brief Read angular velocity from the gyroscope without converting it
+   *
+   * The driver leaves the gyroscope at its power on full scale of ±250°/s.
+   *
+   * @return raw_rotation - gyroscope counts tagged with their full scale
+   */
+  raw_rotation read_raw_rotation();
+
+  /**
+   * @brief Configure which events the device detects and signals on INT
+   *
+   * Letting the device watch for events allows the host to sleep until the
+   * INT pin is asserted, instead of polling `read()`.
+   *
+   * @param p_settings - events to detect and how INT is driven
+   * @throws hal::argument_out_of_domain - when a threshold or duration is
+   * outside of what the device supports, both motion and free fall detection
+   * are requested, or free fall detection is requested from a part with wake
+   * on motion.
+   */
+  void configure_events(const event_settings& p_settings);
+
+  /**
+   * @brief Read and clear the events that have occurred
+   *
+   * This is a single register read, unless a motion event occurred, in which
+   * case the axes of the motion are read as well.
+   *
+   * @return events_t - events since the last call
+   */
+  events_t read_events();
+
   /**
    * @brief Power on the device
    */
@@ -70,16 +590,144 @@ public:
    */
   void power_off();
 
+  /**
+   * @brief Select which parts of the device are powered
+   *
+   * `power_off()` and `power_on()` keep the profile, putting the whole device
+   * to sleep and waking it back up into the same profile.
+   *
+   * @param p_profile - parts to keep running and whether to cycle
+   * @return hal::time_duration - the wake up latency of the profile, see
+   * `wake_up_latency()`.
+   * @throws hal::argument_out_of_domain - when cycle mode is requested with
+   * the gyroscope running.
+   */
+  hal::time_duration configure_power(const power_profile& p_profile);
+
+  /**
+   * @brief Longest wait for a fresh sample after switching to a profile
+   *
+   * Turning a sensor on takes its start up time before its data is valid. In
+   * cycle mode the device also sleeps for up to a full period before the next
+   * sample is captured, which is the latency for every sample after that too.
+   *
+   * @param p_profile - profile to switch to
+   * @return hal::time_duration - worst case time until a sample captured
+   * under the profile is available
+   */
+  static constexpr hal::time_duration wake_up_latency(
+    const power_profile& p_profile)
+  {
+    hal::time_duration latency = Traits::accelerometer_start_up;
+    if (p_profile.gyroscope) {
+      latency = std::max<hal::time_duration>(latency,
+                                             Traits::gyroscope_start_up);
+    }
+    if (p_profile.cycle) {
+      latency +=
+        Traits::cycle_periods[static_cast<std::size_t>(*p_profile.cycle)];
+    }
+    return latency;
+  }
+
+  /**
+   * @brief The lowest power profile that captures accelerometer samples at
+   * a rate
+   *
+   * Picks the slowest cycle mode rate that is at least `p_rate`, with the
+   * gyroscope and temperature sensor off. Rates faster than cycle mode
+   * supports get the accelerometer running continuously, in which case the
+   * rate must also be set with `configure_sample_rate()`.
+   *
+   * @param p_rate - accelerometer samples needed per second
+   * @return power_profile - profile to pass to `configure_power()`
+   */
+  static constexpr power_profile accelerometer_profile(hal::hertz p_rate)
+  {
+    power_profile profile{};
+    profile.gyroscope = false;
+    profile.temperature = false;
+
+    for (std::size_t code = 0; code < Traits::cycle_periods.size(); code++) {
+      const auto period =
+        std::chrono::duration<float>(Traits::cycle_periods[code]).count();
+      if (period * p_rate <= 1.0f) {
+        profile.cycle = static_cast<wake_rate>(code);
+        break;
+      }
+    }
+
+    return profile;
+  }
+
 private:
   accelerometer::read_t driver_read() override;
+  fifo_view read_fifo_frames(std::span<hal::byte> p_buffer,
+                             std::size_t p_frames);
+  void apply_auto_range(const raw_acceleration& p_sample);
+  void begin_scale_change(hal::byte p_previous_gscale);
+  hal::byte read_interrupt_status();
+  void track_interrupt_status(hal::byte p_status);
+  void write_interrupt_enable();
+  void check_fifo_overflow();
+  hal::byte read_output_after_scale_change(std::span<hal::byte> p_data);
+
+  /**
+   * @brief Read the output registers starting at ACCEL_XOUT_H
+   *
+   * @param p_data - where to place the bytes, at most the acceleration and
+   * temperature registers
+   * @return hal::byte - full scale code the data was captured at
+   */
+  hal::byte read_output(std::span<hal::byte> p_data)
+  {
+    if (m_scale_settling) [[unlikely]] {
+      return read_output_after_scale_change(p_data);
+    }
+
+    hal::write_then_read(*m_i2c,
+                         m_address,
+                         std::array{ Traits::acceleration_output_register },
+                         p_data,
+                         hal::never_timeout());
+    return m_gscale;
+  }
 
   /// The I2C peripheral used for communication with the device.
   hal::i2c* m_i2c;
+  /// Decides when to change the full scale, if automatic ranging is enabled.
+  std::optional<auto_range> m_auto_range;
   /// Gravity scale is the maximum absolute value of acceleration in units of
   /// earth's gravity (g) that the device will read.
-  hal::byte m_gscale;
+  hal::byte m_gscale = 0;
+  /// Last value written to the acceleration configuration register.
+  hal::byte m_accel_config = 0;
+  /// Interrupts enabled by `configure_events()`.
+  hal::byte m_interrupt_enable = 0;
+  /// Full scale the output registers were captured at until the device
+  /// reports a fresh sample, valid while `m_scale_settling` is set.
+  hal::byte m_previous_gscale = 0;
+  /// Interrupt status bits cleared by reads other than `read_events()`,
+  /// handed out by the next one.
+  hal::byte m_missed_status = 0;
+  /// The full scale changed and the output registers may still hold a sample
+  /// captured at the previous one.
+  bool m_scale_settling = false;
+  /// FIFO_OFLOW was seen in INT_STATUS since the FIFO was last reset. Kept
+  /// apart from `m_missed_status` so that `read_events()` clearing it does not
+  /// let `read_fifo()` drain misaligned frames.
+  bool m_fifo_overflowed = false;
+  /// Samples are being buffered in the FIFO.
+  bool m_fifo_enabled = false;
   /// The address used to communicate with the device.
   hal::byte m_address;
 };
 
+using mpu6050 = basic_mpu<mpu6050_traits>;
+using mpu6500 = basic_mpu<mpu6500_traits>;
+using mpu9250 = basic_mpu<mpu9250_traits>;
+
+extern template class basic_mpu<mpu6050_traits>;
+extern template class basic_mpu<mpu6500_traits>;
+extern template class basic_mpu<mpu9250_traits>;
 }  // namespace hal::mpu
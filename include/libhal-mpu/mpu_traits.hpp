@@ -0,0 +1,153 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#include <libhal/units.hpp>
+
+namespace hal::mpu {
+/// Registers shared by every member of the MPU family
+struct mpu_register_map
+{
+  /// Divides the gyroscope output rate down to the sample rate.
+  static constexpr hal::byte sample_rate_divider_register = 0x19;
+  /// Configures the digital low pass filter and FSYNC.
+  static constexpr hal::byte config_register = 0x1A;
+  /// The address of the register used to configure gravity scale the device.
+  static constexpr hal::byte configuration_register = 0x1C;
+  /// Motion detection threshold, see `motion_g_per_lsb` for its units.
+  static constexpr hal::byte motion_threshold_register = 0x1F;
+  /// Selects which sensors are written into the FIFO.
+  static constexpr hal::byte fifo_enable_register = 0x23;
+  /// Configures the behavior of the INT pin (polarity, drive, latching).
+  static constexpr hal::byte interrupt_pin_config_register = 0x37;
+  /// Selects which events assert the INT pin.
+  static constexpr hal::byte interrupt_enable_register = 0x38;
+  /// Reports which events have occurred, cleared on read.
+  static constexpr hal::byte interrupt_status_register = 0x3A;
+  /// First of the acceleration output registers (ACCEL_XOUT_H), directly
+  /// followed by TEMP_OUT_H and TEMP_OUT_L.
+  static constexpr hal::byte acceleration_output_register = 0x3B;
+  /// The address of the first gyroscope output register (GYRO_XOUT_H).
+  static constexpr hal::byte gyroscope_register = 0x43;
+  /// Enables and resets the FIFO.
+  static constexpr hal::byte user_control_register = 0x6A;
+  /// The address of the register used to initilize the device.
+  static constexpr hal::byte initalizing_register = 0x6B;
+  /// Puts individual accelerometer and gyroscope axes into standby.
+  static constexpr hal::byte power_management_2_register = 0x6C;
+  /// Number of bytes in the FIFO, high byte first, followed by FIFO_COUNT_L.
+  static constexpr hal::byte fifo_count_register = 0x72;
+  /// Reading this register pops bytes off of the FIFO.
+  static constexpr hal::byte fifo_data_register = 0x74;
+  /// Read-only register holding the device ID.
+  static constexpr hal::byte who_am_i_register = 0x75;
+};
+
+/// MPU6050 accelerometer and gyroscope
+struct mpu6050_traits : mpu_register_map
+{
+  /// Value of the WHO_AM_I register
+  static constexpr hal::byte device_id = 0x68;
+  /// Size of the FIFO in bytes
+  static constexpr std::size_t fifo_size = 1024;
+  /// Motion detection runs on high pass filtered data for a duration, rather
+  /// than comparing each sample against the one before it.
+  static constexpr bool wake_on_motion = false;
+  /// Acceleration represented by one LSB of the motion and free fall
+  /// thresholds, in g.
+  static constexpr float motion_g_per_lsb = 0.002f;
+  /// TEMP_OUT counts per °C
+  static constexpr double temperature_sensitivity = 340.0;
+  /// Temperature, in °C, when TEMP_OUT reads 0
+  static constexpr double temperature_offset = 36.53;
+  /// Time between samples in cycle mode for each LP_WAKE_CTRL code, 1.25Hz,
+  /// 5Hz, 20Hz and 40Hz.
+  static constexpr std::array<std::chrono::milliseconds, 4> cycle_periods{
+    std::chrono::milliseconds(800),
+    std::chrono::milliseconds(200),
+    std::chrono::milliseconds(50),
+    std::chrono::milliseconds(25),
+  };
+  /// The cycle mode rate is set by the upper bits of PWR_MGMT_2 rather than
+  /// a register of its own.
+  static constexpr bool cycle_rate_in_power_management_2 = true;
+  /// Time for the gyroscope to produce valid data after leaving standby
+  static constexpr std::chrono::milliseconds gyroscope_start_up{ 30 };
+  /// Time for the accelerometer to produce valid data after leaving sleep
+  static constexpr std::chrono::milliseconds accelerometer_start_up{ 20 };
+
+  /// Free-fall detection threshold, 1 LSB = 2mg.
+  static constexpr hal::byte free_fall_threshold_register = 0x1D;
+  /// Free-fall detection duration, 1 LSB = 1ms.
+  static constexpr hal::byte free_fall_duration_register = 0x1E;
+  /// Motion detection duration, 1 LSB = 1ms.
+  static constexpr hal::byte motion_duration_register = 0x20;
+  /// Reports the axis and polarity of the last motion event.
+  static constexpr hal::byte motion_detect_status_register = 0x61;
+};
+
+/// MPU6500 accelerometer and gyroscope
+struct mpu6500_traits : mpu_register_map
+{
+  /// Value of the WHO_AM_I register
+  static constexpr hal::byte device_id = 0x70;
+  /// Size of the FIFO in bytes, at its power on setting
+  static constexpr std::size_t fifo_size = 512;
+  /// Motion detection compares each sample against the one before it, with
+  /// no duration and no report of which axis moved.
+  static constexpr bool wake_on_motion = true;
+  /// Acceleration represented by one LSB of the wake on motion threshold, in
+  /// g.
+  static constexpr float motion_g_per_lsb = 0.004f;
+  /// TEMP_OUT counts per °C
+  static constexpr double temperature_sensitivity = 333.87;
+  /// Temperature, in °C, when TEMP_OUT reads 0
+  static constexpr double temperature_offset = 21.0;
+  /// Time between samples in cycle mode for each of the LP_ACCEL_ODR codes
+  /// in `cycle_rate_codes`, 1.95Hz, 7.81Hz, 31.25Hz and 62.5Hz. These are the
+  /// closest rates at or above the ones of the MPU6050.
+  static constexpr std::array<std::chrono::milliseconds, 4> cycle_periods{
+    std::chrono::milliseconds(512),
+    std::chrono::milliseconds(128),
+    std::chrono::milliseconds(32),
+    std::chrono::milliseconds(16),
+  };
+  /// The cycle mode rate has its own register, `low_power_rate_register`.
+  static constexpr bool cycle_rate_in_power_management_2 = false;
+  /// LP_ACCEL_ODR values matching each entry of `cycle_periods`
+  static constexpr std::array<hal::byte, 4> cycle_rate_codes{ 3, 5, 7, 8 };
+  /// Time for the gyroscope to produce valid data after leaving standby
+  static constexpr std::chrono::milliseconds gyroscope_start_up{ 35 };
+  /// Time for the accelerometer to produce valid data after leaving sleep
+  static constexpr std::chrono::milliseconds accelerometer_start_up{ 20 };
+
+  /// Sample rate of the accelerometer in cycle mode (LP_ACCEL_ODR).
+  static constexpr hal::byte low_power_rate_register = 0x1E;
+  /// Enables wake on motion and selects what samples are compared against.
+  static constexpr hal::byte accel_intelligence_control_register = 0x69;
+};
+
+/// MPU9250, an MPU6500 with an AK8963 magnetometer in the same package. The
+/// magnetometer sits behind its own I2C address and is not covered here.
+struct mpu9250_traits : mpu6500_traits
+{
+  /// Value of the WHO_AM_I register
+  static constexpr hal::byte device_id = 0x71;
+};
+}  // namespace hal::mpu
@@ -0,0 +1,124 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+#include <libhal-mpu/raw_rotation.hpp>
+
+namespace hal::mpu {
+/// Angle in fixed point degrees with 16 fractional bits (Q16.16), so that
+/// `1 << 16` is one degree.
+using fixed_angle = std::int32_t;
+
+/// One degree as a `fixed_angle`
+constexpr fixed_angle fixed_degree = 1 << 16;
+
+/// Tilt of the device relative to gravity
+struct tilt_t
+{
+  /// Rotation about the Y axis, from -90° to 90°
+  fixed_angle pitch = 0;
+  /// Rotation about the X axis, from -180° to 180°
+  fixed_angle roll = 0;
+};
+
+/**
+ * @brief Arc tangent of y/x over all four quadrants in fixed point
+ *
+ * Computed with 16 CORDIC iterations using only shifts and adds, which keeps
+ * the error under 0.01° and makes it suitable for targets without an FPU.
+ *
+ * @param p_y - y coordinate, must be within ±2^28
+ * @param p_x - x coordinate, must be within ±2^28
+ * @return fixed_angle - angle from -180° to 180°. Returns 0 when both inputs
+ * are 0.
+ */
+fixed_angle fixed_atan2(std::int32_t p_y, std::int32_t p_x);
+
+/**
+ * @brief Compute pitch and roll from a raw acceleration sample
+ *
+ * Only the direction of the sample matters, so the full scale it was captured
+ * at does not need to be known. The result is only meaningful while the
+ * device is not otherwise accelerating.
+ *
+ * @param p_sample - raw acceleration sample
+ * @return tilt_t - pitch and roll of the device
+ */
+tilt_t tilt(const raw_acceleration& p_sample);
+
+/**
+ * @brief Fuses accelerometer tilt with gyroscope rates in fixed point
+ *
+ * The gyroscope is integrated to follow fast changes while the accelerometer
+ * tilt slowly pulls the estimate back to remove gyroscope drift. Every step is
+ * integer arithmetic, and no division is performed.
+ */
+class complementary_filter
+{
+public:
+  struct settings
+  {
+    /// Weight given to the gyroscope estimate on each update, where 1 << 16 is
+    /// 1.0. The remainder is given to the accelerometer tilt. The default is
+    /// 0.98.
+    std::int32_t gyroscope_weight = 64225;
+  };
+
+  /**
+   * @brief Construct a new complementary filter
+   *
+   * @param p_settings - filter weighting
+   */
+  explicit complementary_filter(settings p_settings);
+
+  /**
+   * @brief Advance the estimate by one sample
+   *
+   * The first update after construction or `reset()` uses the accelerometer
+   * tilt as is.
+   *
+   * @param p_acceleration - raw acceleration sample
+   * @param p_rotation - raw gyroscope sample taken at the same time
+   * @param p_period_us - time since the previous update in microseconds
+   * @return tilt_t - fused pitch and roll
+   */
+  tilt_t update(const raw_acceleration& p_acceleration,
+                const raw_rotation& p_rotation,
+                std::uint32_t p_period_us);
+
+  /**
+   * @brief Discard the current estimate
+   */
+  void reset();
+
+  /**
+   * @brief The latest fused estimate
+   *
+   * @return tilt_t - fused pitch and roll
+   */
+  [[nodiscard]] tilt_t estimate() const
+  {
+    return m_estimate;
+  }
+
+private:
+  settings m_settings;
+  tilt_t m_estimate{};
+  bool m_initialized = false;
+};
+}  // namespace hal::mpu
@@ -0,0 +1,94 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <libhal-util/map.hpp>
+#include <libhal/accelerometer.hpp>
+#include <libhal/units.hpp>
+
+namespace hal::mpu {
+/**
+ * @brief Acceleration exactly as it was held in the device's output registers
+ *
+ * Each axis is a signed 16-bit count where the full range of the integer maps
+ * onto the full scale the device was configured for when the sample was
+ * captured. Keeping samples in this form lets processing stay in integer
+ * arithmetic until a value in g is actually needed.
+ */
+struct raw_acceleration
+{
+  std::int16_t x = 0;
+  std::int16_t y = 0;
+  std::int16_t z = 0;
+  /// Full scale code the sample was captured at, shared by every device in
+  /// this library: 0 = ±2g, 1 = ±4g, 2 = ±8g, 3 = ±16g.
+  hal::byte gscale = 0;
+};
+
+/**
+ * @brief Returns the maximum absolute acceleration, in g, of a full scale code
+ *
+ * @param p_gscale - full scale code from 0 (±2g) to 3 (±16g)
+ * @return constexpr float - maximum acceleration in g
+ */
+constexpr float full_scale_g(hal::byte p_gscale)
+{
+  return static_cast<float>(1 << (static_cast<int>(p_gscale) + 1));
+}
+
+/**
+ * @brief Convert counts captured at a full scale into counts at ±2g
+ *
+ * Samples captured at different full scales can be compared, summed and
+ * averaged once they are all in ±2g counts, 16384 per g. Counts from the
+ * ±16g full scale need 19 bits, hence the wider result.
+ *
+ * @param p_counts - one axis of a raw sample
+ * @param p_gscale - full scale code the sample was captured at
+ * @return constexpr std::int32_t - the same acceleration in ±2g counts
+ */
+constexpr std::int32_t normalize(std::int16_t p_counts, hal::byte p_gscale)
+{
+  return static_cast<std::int32_t>(p_counts) * (1 << p_gscale);
+}
+
+/**
+ * @brief Convert a raw sample into the units of `hal::accelerometer::read_t`
+ *
+ * @param p_sample - raw sample to convert
+ * @return accelerometer::read_t - acceleration in g
+ */
+inline accelerometer::read_t to_read_t(const raw_acceleration& p_sample)
+{
+  constexpr auto max =
+    static_cast<float>(std::numeric_limits<std::int16_t>::max());
+  constexpr auto min =
+    static_cast<float>(std::numeric_limits<std::int16_t>::min());
+
+  const auto output_limits = full_scale_g(p_sample.gscale);
+  auto input_range = std::make_pair(max, min);
+  auto output_range = std::make_pair(-output_limits, output_limits);
+
+  return {
+    .x = hal::map(p_sample.x, input_range, output_range),
+    .y = hal::map(p_sample.y, input_range, output_range),
+    .z = hal::map(p_sample.z, input_range, output_range),
+  };
+}
+}  // namespace hal::mpu
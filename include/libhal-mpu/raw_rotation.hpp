@@ -0,0 +1,50 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <libhal/units.hpp>
+
+namespace hal::mpu {
+/**
+ * @brief Angular velocity exactly as it was held in the gyroscope's output
+ * registers
+ *
+ * Each axis is a signed 16-bit count where the full range of the integer maps
+ * onto the full scale the gyroscope was configured for.
+ */
+struct raw_rotation
+{
+  std::int16_t x = 0;
+  std::int16_t y = 0;
+  std::int16_t z = 0;
+  /// Full scale code the sample was captured at: 0 = ±250°/s,
+  /// 1 = ±500°/s, 2 = ±1000°/s, 3 = ±2000°/s.
+  hal::byte scale = 0;
+};
+
+/**
+ * @brief Returns the maximum absolute angular velocity, in degrees per second,
+ * of a gyroscope full scale code
+ *
+ * @param p_scale - full scale code from 0 (±250°/s) to 3 (±2000°/s)
+ * @return constexpr std::int32_t - maximum angular velocity in °/s
+ */
+constexpr std::int32_t full_scale_dps(hal::byte p_scale)
+{
+  return 250 << p_scale;
+}
+}  // namespace hal::mpu
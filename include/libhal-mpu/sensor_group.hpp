@@ -0,0 +1,223 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+
+namespace hal::mpu {
+/// A driver with an inline `read_raw()`, such as `mpu6050` or `lis3dhtr`
+template<class T>
+concept raw_accelerometer = requires(T& p_driver) {
+  { p_driver.read_raw() } -> std::same_as<raw_acceleration>;
+};
+
+/**
+ * @brief Reads several accelerometers as close together in time as possible
+ *
+ * Reading each device through its own `read()` call leaves whatever else
+ * runs between those calls as skew between the samples. A group issues the
+ * reads back to back, in the order the drivers were given, through their
+ * inline `read_raw()`, so the only skew left is the bus time of the reads
+ * themselves. Combine the resulting frame with `average()` or `median()`.
+ *
+ * Drivers may share a bus or sit on different ones, and may be of different
+ * parts:
+ *
+ *     hal::mpu::sensor_group group(primary, secondary, lis);
+ *     auto frame = group.read();
+ *     auto voted = hal::mpu::median(frame);
+ *
+ * @tparam Sensors - driver types, deduced from the constructor
+ */
+template<raw_accelerometer... Sensors>
+class sensor_group
+{
+public:
+  static_assert(sizeof...(Sensors) > 0, "A group needs at least one sensor");
+
+  /// Number of sensors in the group
+  static constexpr std::size_t size = sizeof...(Sensors);
+  /// One sample from each sensor, in the order the sensors were given
+  using frame_t = std::array<raw_acceleration, size>;
+
+  /**
+   * @brief Construct a new sensor group
+   *
+   * The group only refers to the drivers, they must outlive it.
+   *
+   * @param p_sensors - drivers to read, in the order they are read
+   */
+  explicit sensor_group(Sensors&... p_sensors)
+    : m_sensors(&p_sensors...)
+  {
+  }
+
+  /**
+   * @brief Read one sample from every sensor back to back
+   *
+   * @return frame_t - each sample tagged with the full scale of its sensor
+   */
+  frame_t read()
+  {
+    // Elements of a braced initializer list are evaluated in order
+    return std::apply(
+      [](auto*... p_sensor) { return frame_t{ p_sensor->read_raw()... }; },
+      m_sensors);
+  }
+
+private:
+  std::tuple<Sensors*...> m_sensors;
+};
+
+/// How `vote()` combines the samples of a frame
+enum class vote_kind : std::uint8_t
+{
+  /// Mean of each axis, reduces noise
+  average,
+  /// Median of each axis, rejects a faulty sensor
+  median,
+};
+
+/**
+ * @brief Combine the samples of a frame, axis by axis
+ *
+ * Samples are brought to a common full scale before being combined, so
+ * sensors set to different ranges can be mixed. Everything stays in integer
+ * counts, results are rounded to the nearest count, half away from zero.
+ *
+ * @tparam Kind - how to combine each axis
+ * @param p_frame - samples taken at the same time, such as from
+ * `sensor_group::read()`
+ * @return raw_acceleration - the combined sample, at the largest full scale
+ * within the frame
+ */
+template<vote_kind Kind, std::size_t N>
+constexpr raw_acceleration vote(const std::array<raw_acceleration, N>& p_frame)
+{
+  static_assert(N > 0);
+
+  // The largest full scale within the frame fits every sample
+  hal::byte gscale = 0;
+  for (const auto& sample : p_frame) {
+    gscale = std::max(gscale, sample.gscale);
+  }
+
+  auto divide_rounded = [](std::int32_t p_value, std::int32_t p_divisor) {
+    const auto half = p_divisor / 2;
+    return (p_value < 0 ? p_value - half : p_value + half) / p_divisor;
+  };
+
+  auto axis = [&](std::int16_t raw_acceleration::*p_axis) {
+    std::array<std::int32_t, N> values{};
+    for (std::size_t i = 0; i < N; i++) {
+      values[i] = normalize(p_frame[i].*p_axis, p_frame[i].gscale);
+    }
+
+    std::int32_t result = 0;
+    if constexpr (Kind == vote_kind::average) {
+      std::int32_t sum = 0;
+      for (const auto value : values) {
+        sum += value;
+      }
+      result = divide_rounded(sum, static_cast<std::int32_t>(N) << gscale);
+    } else if constexpr (N % 2 == 0) {
+      std::sort(values.begin(), values.end());
+      result = divide_rounded(values[N / 2 - 1] + values[N / 2], 2 << gscale);
+    } else {
+      std::sort(values.begin(), values.end());
+      result = divide_rounded(values[N / 2], 1 << gscale);
+    }
+    return static_cast<std::int16_t>(result);
+  };
+
+  return {
+    .x = axis(&raw_acceleration::x),
+    .y = axis(&raw_acceleration::y),
+    .z = axis(&raw_acceleration::z),
+    .gscale = gscale,
+  };
+}
+
+/**
+ * @brief Mean of the samples of a frame, axis by axis
+ *
+ * Averaging reduces noise but lets a faulty sensor pull the result, use
+ * `median()` to reject one. See `vote()`.
+ *
+ * @param p_frame - samples taken at the same time
+ * @return raw_acceleration - the mean, at the largest full scale within the
+ * frame
+ */
+template<std::size_t N>
+constexpr raw_acceleration average(
+  const std::array<raw_acceleration, N>& p_frame)
+{
+  return vote<vote_kind::average>(p_frame);
+}
+
+/**
+ * @brief Median of the samples of a frame, axis by axis
+ *
+ * With three or more sensors, one sensor reporting nonsense on an axis does
+ * not affect the result. With an even number of sensors, the two middle
+ * values are averaged. See `vote()`.
+ *
+ * @param p_frame - samples taken at the same time
+ * @return raw_acceleration - the median, at the largest full scale within
+ * the frame
+ */
+template<std::size_t N>
+constexpr raw_acceleration median(
+  const std::array<raw_acceleration, N>& p_frame)
+{
+  return vote<vote_kind::median>(p_frame);
+}
+
+/**
+ * @brief Largest disagreement between the samples of a frame
+ *
+ * Compare this against a limit to detect that a sensor has failed or come
+ * loose.
+ *
+ * @param p_frame - samples taken at the same time
+ * @return std::int32_t - largest difference on any axis between any two
+ * samples, in counts at the ±2g full scale
+ */
+template<std::size_t N>
+constexpr std::int32_t spread(const std::array<raw_acceleration, N>& p_frame)
+{
+  std::int32_t widest = 0;
+  for (const auto axis :
+       { &raw_acceleration::x, &raw_acceleration::y, &raw_acceleration::z }) {
+    auto [low, high] = std::minmax_element(
+      p_frame.begin(), p_frame.end(), [axis](const auto& p_a, const auto& p_b) {
+        return normalize(p_a.*axis, p_a.gscale) <
+               normalize(p_b.*axis, p_b.gscale);
+      });
+    widest = std::max(widest,
+                      normalize(high->*axis, high->gscale) -
+                        normalize(low->*axis, low->gscale));
+  }
+  return widest;
+}
+}  // namespace hal::mpu
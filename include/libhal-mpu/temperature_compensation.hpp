@@ -0,0 +1,169 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+
+namespace hal::mpu {
+/// Temperature in fixed point degrees Celsius with 16 fractional bits
+/// (Q16.16), so that `1 << 16` is one degree.
+using fixed_celsius = std::int32_t;
+
+/// One degree Celsius as a `fixed_celsius`
+constexpr fixed_celsius fixed_celsius_degree = 1 << 16;
+
+/// Acceleration sample together with the die temperature it was captured at
+struct thermal_sample
+{
+  raw_acceleration acceleration{};
+  fixed_celsius temperature = 0;
+};
+
+/**
+ * @brief Polynomial model of accelerometer bias over temperature
+ *
+ * For each axis, the bias at temperature T is
+ * `offset + linear * (T - reference) + quadratic * (T - reference)²`.
+ * Biases are in counts at the ±2g full scale, 16384 per g, so that one model
+ * serves every full scale.
+ */
+struct temperature_model
+{
+  struct axis_model
+  {
+    /// Bias at the reference temperature, in ±2g counts
+    std::int32_t offset = 0;
+    /// Change in bias per °C, in ±2g counts with 16 fractional bits
+    std::int32_t linear = 0;
+    /// Change in bias per °C², in ±2g counts with 16 fractional bits
+    std::int32_t quadratic = 0;
+  };
+
+  /// Temperature the model is centered on
+  fixed_celsius reference = 25 * fixed_celsius_degree;
+  /// Model for the X, Y and Z axis in that order
+  std::array<axis_model, 3> axes{};
+};
+
+/**
+ * @brief Removes temperature dependent bias from acceleration samples
+ *
+ * Every step is integer arithmetic and the result is a `raw_acceleration` at
+ * the full scale of the input, so compensated samples can be handed to
+ * anything that takes raw samples.
+ */
+class temperature_compensation
+{
+public:
+  /**
+   * @brief Construct a new temperature compensation
+   *
+   * @param p_model - bias model, such as one from `fit_temperature_model()`
+   */
+  explicit temperature_compensation(const temperature_model& p_model)
+    : m_model(p_model)
+  {
+  }
+
+  /**
+   * @brief Subtract the modeled bias from a sample
+   *
+   * @param p_sample - sample and the temperature it was captured at
+   * @return raw_acceleration - the compensated sample, saturated to the
+   * range of the counts
+   */
+  [[nodiscard]] raw_acceleration apply(const thermal_sample& p_sample) const
+  {
+    const std::int64_t delta = p_sample.temperature - m_model.reference;
+    const std::int64_t delta_squared = (delta * delta) >> 16;
+    const auto gscale = p_sample.acceleration.gscale;
+
+    auto correct = [&](std::int16_t p_counts,
+                       const temperature_model::axis_model& p_axis) {
+      // Bias in ±2g counts with 16 fractional bits
+      const std::int64_t bias =
+        (static_cast<std::int64_t>(p_axis.offset) << 16) +
+        ((p_axis.linear * delta) >> 16) +
+        ((p_axis.quadratic * delta_squared) >> 16);
+      // Each step up in full scale halves the counts per g, round to nearest
+      const auto shift = 16 + gscale;
+      const auto scaled_bias =
+        (bias + (std::int64_t{ 1 } << (shift - 1))) >> shift;
+      const auto corrected = std::clamp<std::int64_t>(
+        p_counts - scaled_bias,
+        std::numeric_limits<std::int16_t>::min(),
+        std::numeric_limits<std::int16_t>::max());
+      return static_cast<std::int16_t>(corrected);
+    };
+
+    return {
+      .x = correct(p_sample.acceleration.x, m_model.axes[0]),
+      .y = correct(p_sample.acceleration.y, m_model.axes[1]),
+      .z = correct(p_sample.acceleration.z, m_model.axes[2]),
+      .gscale = gscale,
+    };
+  }
+
+  /**
+   * @brief The model in use
+   *
+   * @return const temperature_model& - bias model
+   */
+  [[nodiscard]] const temperature_model& model() const
+  {
+    return m_model;
+  }
+
+private:
+  temperature_model m_model;
+};
+
+/// Order of the polynomial fitted by `fit_temperature_model()`
+enum class temperature_fit : std::uint8_t
+{
+  linear,
+  quadratic,
+};
+
+/**
+ * @brief Fit a bias model to samples logged across a temperature range
+ *
+ * The device must hold still in the same orientation while the samples are
+ * logged, such as sitting flat in a thermal chamber, so that any change in
+ * the readings is bias. The model is a least squares fit of the difference
+ * between each sample and `p_expected`. This runs in floating point and is
+ * meant for calibration, not for the sampling loop.
+ *
+ * @param p_samples - samples logged while the temperature varies
+ * @param p_expected - what the device would read without bias, such as 1g on
+ * Z when lying flat
+ * @param p_fit - order of the polynomial
+ * @param p_reference - temperature to center the model on
+ * @return temperature_model - the fitted model
+ * @throws hal::argument_out_of_domain - when the samples do not cover enough
+ * distinct temperatures to fit the requested order.
+ */
+temperature_model fit_temperature_model(
+  std::span<const thermal_sample> p_samples,
+  const raw_acceleration& p_expected,
+  temperature_fit p_fit,
+  fixed_celsius p_reference = 25 * fixed_celsius_degree);
+}  // namespace hal::mpu
@@ -0,0 +1,344 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <utility>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+#include <libhal/units.hpp>
+
+namespace hal::mpu {
+/// Selects one axis of a three axis sample
+enum class axis : std::uint8_t
+{
+  x,
+  y,
+  z,
+};
+
+/**
+ * @brief Reduces blocks of samples to vibration features at the edge
+ *
+ * Each block has its mean removed, is weighted by a Hann window and run
+ * through an in-place radix-2 real FFT. Only the features are kept: RMS, the
+ * frequency and amplitude of the strongest component, and the energy in a set
+ * of frequency bands. All storage is held within the object, no memory is
+ * allocated.
+ *
+ * The real FFT packs the block into a complex FFT of half the length and
+ * untangles the result, so the work buffer is `SampleCount` floats and the
+ * twiddle tables another `SampleCount` floats in total. The trigonometry is
+ * only done at construction.
+ *
+ * @tparam SampleCount - samples per block, a power of 2 of at least 4
+ * @tparam BandCount - number of frequency bands to report energy for
+ */
+template<std::size_t SampleCount, std::size_t BandCount = 4>
+class vibration_spectrum
+{
+public:
+  static_assert(SampleCount >= 4 && std::has_single_bit(SampleCount),
+                "SampleCount must be a power of 2 of at least 4");
+
+  /// Number of frequency bins from DC to the Nyquist frequency inclusive
+  static constexpr std::size_t bin_count = SampleCount / 2 + 1;
+
+  struct settings
+  {
+    /// Rate the samples in each block were captured at
+    hal::hertz sample_rate = 1000.0f;
+    /// Edges of the energy bands in ascending order. Band `i` covers the
+    /// frequencies from `band_edges[i]` up to, but not including,
+    /// `band_edges[i + 1]`.
+    std::array<hal::hertz, BandCount + 1> band_edges{};
+  };
+
+  struct features_t
+  {
+    /// Root mean square of the block, in g, after removing its mean
+    float rms = 0.0f;
+    /// Frequency of the strongest component, interpolated between bins
+    hal::hertz peak_frequency = 0.0f;
+    /// Amplitude, in g, of the strongest component as seen in its bin. A
+    /// component that falls between two bins reads up to 15% low.
+    float peak_amplitude = 0.0f;
+    /// Mean square acceleration, in g², within each band
+    std::array<float, BandCount> band_energy{};
+  };
+
+  /**
+   * @brief Construct a new spectrum analyzer and its twiddle tables
+   *
+   * @param p_settings - sample rate and bands
+   */
+  explicit vibration_spectrum(settings p_settings)
+    : m_settings(p_settings)
+  {
+    for (std::size_t i = 0; i < half_count; i++) {
+      const auto angle = 2.0 * std::numbers::pi * static_cast<double>(i) /
+                         static_cast<double>(SampleCount);
+      m_cosine[i] = static_cast<float>(std::cos(angle));
+      m_sine[i] = static_cast<float>(std::sin(angle));
+    }
+  }
+
+  /**
+   * @brief Compute the features of one block of samples
+   *
+   * Samples may have been captured at different full scales, each one is
+   * converted using its own scale.
+   *
+   * @param p_samples - one block of samples, oldest first
+   * @param p_axis - which axis of the samples to analyze
+   * @return features_t - features of the block
+   */
+  features_t analyze(std::span<const raw_acceleration, SampleCount> p_samples,
+                     axis p_axis)
+  {
+    features_t features{};
+
+    float mean = 0.0f;
+    for (std::size_t i = 0; i < SampleCount; i++) {
+      m_work[i] = to_g(p_samples[i], p_axis);
+      mean += m_work[i];
+    }
+    mean /= static_cast<float>(SampleCount);
+
+    float sum_of_squares = 0.0f;
+    for (std::size_t i = 0; i < SampleCount; i++) {
+      const auto centered = m_work[i] - mean;
+      sum_of_squares += centered * centered;
+      m_work[i] = centered * hann(i);
+    }
+    features.rms = std::sqrt(sum_of_squares / static_cast<float>(SampleCount));
+
+    transform();
+    find_peak(features);
+    sum_bands(features);
+
+    return features;
+  }
+
+  /**
+   * @brief Frequency at the center of a bin
+   *
+   * @param p_bin - bin index from 0 to `bin_count - 1`
+   * @return hal::hertz - frequency of the bin
+   */
+  [[nodiscard]] hal::hertz bin_frequency(float p_bin) const
+  {
+    return p_bin * m_settings.sample_rate / static_cast<float>(SampleCount);
+  }
+
+private:
+  static constexpr std::size_t half_count = SampleCount / 2;
+  /// Sum of the Hann window over the block
+  static constexpr float window_sum = SampleCount / 2.0f;
+  /// Sum of the squared Hann window over the block
+  static constexpr float window_energy = 3.0f * SampleCount / 8.0f;
+
+  static float to_g(const raw_acceleration& p_sample, axis p_axis)
+  {
+    constexpr float counts_per_full_scale = 32768.0f;
+    std::int16_t counts = p_sample.x;
+    if (p_axis == axis::y) {
+      counts = p_sample.y;
+    } else if (p_axis == axis::z) {
+      counts = p_sample.z;
+    }
+    return static_cast<float>(counts) * full_scale_g(p_sample.gscale) /
+           counts_per_full_scale;
+  }
+
+  /// Periodic Hann window, built from the FFT's cosine table
+  float hann(std::size_t p_index) const
+  {
+    // cos(2πn/N) for the second half of the block is the negated first half
+    const auto cosine = p_index < half_count ? m_cosine[p_index]
+                                             : -m_cosine[p_index - half_count];
+    return 0.5f * (1.0f - cosine);
+  }
+
+  /**
+   * @brief Real FFT of m_work, leaving the power of each bin behind
+   *
+   * On return, the power of bin 0 is at m_work[0], the power of the Nyquist
+   * bin at m_work[1] and the power of every other bin k at m_work[2k].
+   */
+  void transform()
+  {
+    // Treat even samples as real parts and odd samples as imaginary parts of
+    // a complex sequence of half the length.
+    complex_fft();
+
+    // Untangle the spectra of the even and odd samples and combine them.
+    // Bins k and M - k are produced from the same pair of inputs.
+    const auto dc = m_work[0] + m_work[1];
+    const auto nyquist = m_work[0] - m_work[1];
+    m_work[0] = dc * dc;
+    m_work[1] = nyquist * nyquist;
+
+    for (std::size_t k = 1; k <= half_count / 2; k++) {
+      const auto mirror = half_count - k;
+      const auto a = m_work[2 * k];
+      const auto b = m_work[2 * k + 1];
+      const auto c = m_work[2 * mirror];
+      const auto d = m_work[2 * mirror + 1];
+
+      const auto even_real = (a + c) / 2.0f;
+      const auto even_imaginary = (b - d) / 2.0f;
+      const auto odd_real = (b + d) / 2.0f;
+      const auto odd_imaginary = (c - a) / 2.0f;
+
+      // Rotate the odd spectrum by e^(-2πik/N)
+      const auto rotated_real =
+        m_cosine[k] * odd_real + m_sine[k] * odd_imaginary;
+      const auto rotated_imaginary =
+        m_cosine[k] * odd_imaginary - m_sine[k] * odd_real;
+
+      const auto low_real = even_real + rotated_real;
+      const auto low_imaginary = even_imaginary + rotated_imaginary;
+      const auto high_real = even_real - rotated_real;
+      const auto high_imaginary = even_imaginary - rotated_imaginary;
+
+      m_work[2 * k] = low_real * low_real + low_imaginary * low_imaginary;
+      m_work[2 * mirror] =
+        high_real * high_real + high_imaginary * high_imaginary;
+    }
+  }
+
+  /// In-place iterative radix-2 FFT over m_work as interleaved complex values
+  void complex_fft()
+  {
+    constexpr auto bits = std::countr_zero(half_count);
+
+    for (std::size_t i = 0; i < half_count; i++) {
+      const auto reversed = reverse_bits(i, bits);
+      if (i < reversed) {
+        std::swap(m_work[2 * i], m_work[2 * reversed]);
+        std::swap(m_work[2 * i + 1], m_work[2 * reversed + 1]);
+      }
+    }
+
+    for (std::size_t length = 2; length <= half_count; length <<= 1) {
+      const auto stride = SampleCount / length;
+      const auto half_length = length / 2;
+      for (std::size_t start = 0; start < half_count; start += length) {
+        for (std::size_t j = 0; j < half_length; j++) {
+          const auto twiddle_real = m_cosine[j * stride];
+          const auto twiddle_imaginary = -m_sine[j * stride];
+          const auto top = 2 * (start + j);
+          const auto bottom = 2 * (start + j + half_length);
+
+          const auto real = m_work[bottom] * twiddle_real -
+                            m_work[bottom + 1] * twiddle_imaginary;
+          const auto imaginary = m_work[bottom] * twiddle_imaginary +
+                                 m_work[bottom + 1] * twiddle_real;
+
+          m_work[bottom] = m_work[top] - real;
+          m_work[bottom + 1] = m_work[top + 1] - imaginary;
+          m_work[top] += real;
+          m_work[top + 1] += imaginary;
+        }
+      }
+    }
+  }
+
+  static std::size_t reverse_bits(std::size_t p_value, int p_bits)
+  {
+    std::size_t reversed = 0;
+    for (int bit = 0; bit < p_bits; bit++) {
+      reversed = (reversed << 1) | (p_value & 1);
+      p_value >>= 1;
+    }
+    return reversed;
+  }
+
+  /// Power of a bin after transform()
+  float power(std::size_t p_bin) const
+  {
+    if (p_bin == half_count) {
+      return m_work[1];
+    }
+    return m_work[2 * p_bin];
+  }
+
+  void find_peak(features_t& p_features) const
+  {
+    std::size_t peak = 1;
+    for (std::size_t bin = 2; bin < bin_count; bin++) {
+      if (power(bin) > power(peak)) {
+        peak = bin;
+      }
+    }
+
+    const auto magnitude = std::sqrt(power(peak));
+    auto offset = 0.0f;
+
+    // Fit a parabola through the peak and its neighbours to find where the
+    // component sits between bins.
+    if (peak + 1 < bin_count) {
+      const auto left = std::sqrt(power(peak - 1));
+      const auto right = std::sqrt(power(peak + 1));
+      const auto curvature = left - 2.0f * magnitude + right;
+      if (curvature < 0.0f) {
+        offset = 0.5f * (left - right) / curvature;
+      }
+    }
+
+    p_features.peak_frequency =
+      bin_frequency(static_cast<float>(peak) + offset);
+    p_features.peak_amplitude = 2.0f * magnitude / window_sum;
+  }
+
+  void sum_bands(features_t& p_features) const
+  {
+    // Converts the power of a bin to its share of the mean square of the
+    // signal. Bins other than DC and Nyquist stand in for their negative
+    // frequency twin as well, hence the factor of 2.
+    constexpr float mean_square_per_power =
+      2.0f / (static_cast<float>(SampleCount) * window_energy);
+
+    for (std::size_t bin = 1; bin < bin_count; bin++) {
+      const auto frequency = bin_frequency(static_cast<float>(bin));
+      auto share = power(bin) * mean_square_per_power;
+      if (bin == half_count) {
+        share /= 2.0f;
+      }
+      for (std::size_t band = 0; band < BandCount; band++) {
+        if (m_settings.band_edges[band] <= frequency &&
+            frequency < m_settings.band_edges[band + 1]) {
+          p_features.band_energy[band] += share;
+        }
+      }
+    }
+  }
+
+  settings m_settings;
+  /// Block being transformed, then the power of each bin
+  std::array<float, SampleCount> m_work{};
+  /// cos(2πk/N) for k from 0 to N/2 - 1
+  std::array<float, half_count> m_cosine{};
+  /// sin(2πk/N) for k from 0 to N/2 - 1
+  std::array<float, half_count> m_sine{};
+};
+}  // namespace hal::mpu
@@ -0,0 +1,335 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include <libhal-mpu/raw_acceleration.hpp>
+
+namespace hal::mpu {
+/// How consecutive windows relate to each other
+enum class window_kind : std::uint8_t
+{
+  /// Windows follow each other without overlap, one closes every
+  /// `WindowSize` samples.
+  tumbling,
+  /// The window always holds the latest `WindowSize` samples, one closes on
+  /// every sample once the window has filled.
+  sliding,
+};
+
+/**
+ * @brief Min, max, mean, RMS and variance over windows of samples
+ *
+ * Samples are accumulated as integer counts, normalized to the ±2g full scale
+ * so that samples captured at different full scales can be mixed. Every
+ * sample costs a fixed amount of integer work, and conversion to g only
+ * happens when `statistics()` is called.
+ *
+ * Tumbling windows hold no samples at all. Sliding windows keep the samples
+ * of the current window so they can be removed again, plus monotonic queues
+ * that track the minimum and maximum with amortized O(1) work per sample.
+ *
+ * @tparam WindowSize - number of samples in a window
+ * @tparam Kind - tumbling or sliding windows
+ */
+template<std::size_t WindowSize, window_kind Kind = window_kind::tumbling>
+class window_statistics
+{
+public:
+  static_assert(WindowSize > 0, "WindowSize must not be 0");
+  // Keeps n * Σx² and (Σx)² of ±2^18 counts within 64 bits
+  static_assert(WindowSize <= 8192, "WindowSize must be at most 8192");
+
+  struct axis_statistics
+  {
+    /// Smallest acceleration in the window, in g
+    float min = 0.0f;
+    /// Largest acceleration in the window, in g
+    float max = 0.0f;
+    /// Average acceleration in the window, in g
+    float mean = 0.0f;
+    /// Root mean square of the acceleration in the window, in g
+    float rms = 0.0f;
+    /// Variance of the acceleration in the window, in g²
+    float variance = 0.0f;
+  };
+
+  struct statistics_t
+  {
+    axis_statistics x;
+    axis_statistics y;
+    axis_statistics z;
+  };
+
+  /**
+   * @brief Add one sample
+   *
+   * @param p_sample - the sample to add
+   * @return true - a window closed, `statistics()` now covers it
+   * @return false - the window is still filling
+   */
+  bool add(const raw_acceleration& p_sample)
+  {
+    const std::array<std::int32_t, 3> values{
+      normalize(p_sample.x, p_sample.gscale),
+      normalize(p_sample.y, p_sample.gscale),
+      normalize(p_sample.z, p_sample.gscale),
+    };
+
+    if constexpr (Kind == window_kind::tumbling) {
+      for (std::size_t axis = 0; axis < values.size(); axis++) {
+        m_running[axis].include(values[axis]);
+      }
+      m_count++;
+      if (m_count < WindowSize) {
+        return false;
+      }
+      m_closed = m_running;
+      m_running = {};
+      m_count = 0;
+      m_filled = true;
+      return true;
+    } else {
+      for (std::size_t axis = 0; axis < values.size(); axis++) {
+        auto& totals = m_closed[axis];
+        if (m_filled) {
+          totals.exclude(m_window[m_count][axis]);
+        }
+        totals.include_sum(values[axis]);
+        m_window[m_count][axis] = values[axis];
+        m_minimum[axis].push(values[axis], m_sequence);
+        m_maximum[axis].push(values[axis], m_sequence);
+        totals.min = m_minimum[axis].front();
+        totals.max = m_maximum[axis].front();
+      }
+
+      m_sequence++;
+      m_count++;
+      if (m_count == WindowSize) {
+        m_count = 0;
+        m_filled = true;
+      }
+      return m_filled;
+    }
+  }
+
+  /**
+   * @brief Add a batch of samples, such as the result of a FIFO read
+   *
+   * @param p_samples - samples to add, oldest first
+   * @param p_on_window - called with the statistics of each window that
+   * closes while adding the samples
+   */
+  template<class Callback>
+  void add(std::span<const raw_acceleration> p_samples, Callback&& p_on_window)
+  {
+    for (const auto& sample : p_samples) {
+      if (add(sample)) {
+        p_on_window(statistics());
+      }
+    }
+  }
+
+  /**
+   * @brief Statistics of the most recently closed window, converted to g
+   *
+   * @return statistics_t - per axis statistics, all zero until the first
+   * window closes
+   */
+  [[nodiscard]] statistics_t statistics() const
+  {
+    if (!m_filled) {
+      return {};
+    }
+    return {
+      .x = m_closed[0].to_g(),
+      .y = m_closed[1].to_g(),
+      .z = m_closed[2].to_g(),
+    };
+  }
+
+  /**
+   * @brief Drop all samples and start a new window
+   */
+  void reset()
+  {
+    m_closed = {};
+    m_running = {};
+    m_count = 0;
+    m_sequence = 0;
+    m_filled = false;
+    if constexpr (Kind == window_kind::sliding) {
+      for (std::size_t axis = 0; axis < m_minimum.size(); axis++) {
+        m_minimum[axis].clear();
+        m_maximum[axis].clear();
+      }
+    }
+  }
+
+private:
+  /// Counts per g once normalized to the ±2g full scale
+  static constexpr float counts_per_g = 16384.0f;
+
+  struct totals_t
+  {
+    std::int64_t sum = 0;
+    std::int64_t sum_of_squares = 0;
+    std::int32_t min = std::numeric_limits<std::int32_t>::max();
+    std::int32_t max = std::numeric_limits<std::int32_t>::min();
+
+    void include_sum(std::int32_t p_value)
+    {
+      sum += p_value;
+      sum_of_squares += static_cast<std::int64_t>(p_value) * p_value;
+    }
+
+    void include(std::int32_t p_value)
+    {
+      include_sum(p_value);
+      min = p_value < min ? p_value : min;
+      max = p_value > max ? p_value : max;
+    }
+
+    void exclude(std::int32_t p_value)
+    {
+      sum -= p_value;
+      sum_of_squares -= static_cast<std::int64_t>(p_value) * p_value;
+    }
+
+    [[nodiscard]] axis_statistics to_g() const
+    {
+      constexpr auto count = static_cast<std::int64_t>(WindowSize);
+      constexpr auto count_squared = static_cast<float>(count * count);
+      // n * Σx² - (Σx)² is exact in integers, which avoids the cancellation
+      // that computing E[x²] - E[x]² in floating point suffers from.
+      const auto spread = count * sum_of_squares - sum * sum;
+      const auto mean_square =
+        static_cast<float>(sum_of_squares) / static_cast<float>(count);
+
+      return {
+        .min = static_cast<float>(min) / counts_per_g,
+        .max = static_cast<float>(max) / counts_per_g,
+        .mean = static_cast<float>(sum) / static_cast<float>(count) /
+                counts_per_g,
+        .rms = std::sqrt(mean_square) / counts_per_g,
+        .variance = static_cast<float>(spread) / count_squared /
+                    (counts_per_g * counts_per_g),
+      };
+    }
+  };
+
+  using window_t = std::array<std::array<std::int32_t, 3>, WindowSize>;
+
+  /// Queue of samples whose values are monotonic, so that the front is always
+  /// the extreme of the window.
+  template<bool Minimum>
+  class monotonic_queue
+  {
+  public:
+    void push(std::int32_t p_value, std::uint32_t p_sequence)
+    {
+      // Drop the oldest sample if it has left the window. Unsigned
+      // subtraction keeps this correct when the sequence number wraps.
+      if (m_size > 0 && p_sequence - m_entries[m_head].sequence >= WindowSize) {
+        m_head = next(m_head);
+        m_size--;
+      }
+      // Drop samples that can never be the extreme again, as the new sample
+      // is at least as extreme and stays in the window longer.
+      while (m_size > 0 &&
+             !precedes(m_entries[position(m_size - 1)].value, p_value)) {
+        m_size--;
+      }
+      m_entries[position(m_size)] = { .sequence = p_sequence,
+                                      .value = p_value };
+      m_size++;
+    }
+
+    [[nodiscard]] std::int32_t front() const
+    {
+      return m_entries[m_head].value;
+    }
+
+    void clear()
+    {
+      m_head = 0;
+      m_size = 0;
+    }
+
+  private:
+    struct entry_t
+    {
+      std::uint32_t sequence = 0;
+      std::int32_t value = 0;
+    };
+
+    static bool precedes(std::int32_t p_kept, std::int32_t p_new)
+    {
+      if constexpr (Minimum) {
+        return p_kept < p_new;
+      } else {
+        return p_kept > p_new;
+      }
+    }
+
+    static std::size_t next(std::size_t p_index)
+    {
+      return p_index + 1 == WindowSize ? 0 : p_index + 1;
+    }
+
+    [[nodiscard]] std::size_t position(std::size_t p_offset) const
+    {
+      const auto index = m_head + p_offset;
+      return index >= WindowSize ? index - WindowSize : index;
+    }
+
+    std::array<entry_t, WindowSize> m_entries{};
+    std::size_t m_head = 0;
+    std::size_t m_size = 0;
+  };
+
+  struct no_storage
+  {};
+
+  template<class T>
+  using sliding_only =
+    std::conditional_t<Kind == window_kind::sliding, T, no_storage>;
+
+  /// Totals of the last closed window, or of the current one when sliding
+  std::array<totals_t, 3> m_closed{};
+  /// Totals of the window being filled, unused when sliding
+  std::array<totals_t, 3> m_running{};
+  /// Samples in the current window, only kept when sliding
+  [[no_unique_address]] sliding_only<window_t> m_window{};
+  [[no_unique_address]] sliding_only<std::array<monotonic_queue<true>, 3>>
+    m_minimum{};
+  [[no_unique_address]] sliding_only<std::array<monotonic_queue<false>, 3>>
+    m_maximum{};
+  /// Samples added to the current tumbling window, or the slot the next
+  /// sample goes into when sliding
+  std::size_t m_count = 0;
+  /// Sequence number of the next sample, used when sliding
+  std::uint32_t m_sequence = 0;
+  /// Whether a window has closed, or the window has filled when sliding
+  bool m_filled = false;
+};
+}  // namespace hal::mpu
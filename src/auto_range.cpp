@@ -0,0 +1,94 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include <libhal-mpu/auto_range.hpp>
+#include <libhal/error.hpp>
+
+namespace hal::mpu {
+
+namespace {
+/// Absolute value of the largest axis, widened so that -32768 is representable
+std::int32_t peak_magnitude(const raw_acceleration& p_sample)
+{
+  auto magnitude = [](std::int16_t p_axis) {
+    return std::abs(static_cast<std::int32_t>(p_axis));
+  };
+  return std::max(
+    { magnitude(p_sample.x), magnitude(p_sample.y), magnitude(p_sample.z) });
+}
+}  // namespace
+
+auto_range::auto_range(settings p_settings, hal::byte p_gscale)
+  : m_settings(p_settings)
+  , m_gscale(p_gscale)
+{
+  constexpr hal::byte largest_gscale = 3;
+  const bool thresholds_overlap =
+    p_settings.lower_threshold < 0 ||
+    p_settings.lower_threshold * 2 >= p_settings.upper_threshold;
+  const bool scales_invalid =
+    p_settings.minimum_gscale > p_settings.maximum_gscale ||
+    p_settings.maximum_gscale > largest_gscale;
+
+  if (thresholds_overlap || scales_invalid) {
+    hal::safe_throw(hal::argument_out_of_domain(this));
+  }
+
+  m_gscale = std::clamp(
+    m_gscale, m_settings.minimum_gscale, m_settings.maximum_gscale);
+}
+
+void auto_range::gscale(hal::byte p_gscale)
+{
+  m_gscale = p_gscale;
+  m_quiet_samples = 0;
+}
+
+hal::byte auto_range::update(const raw_acceleration& p_sample)
+{
+  // A sample captured before the last range change would be judged against
+  // the wrong scale, so skip it.
+  if (p_sample.gscale != m_gscale) {
+    return m_gscale;
+  }
+
+  const auto peak = peak_magnitude(p_sample);
+
+  if (peak >= m_settings.upper_threshold) {
+    m_quiet_samples = 0;
+    if (m_gscale < m_settings.maximum_gscale) {
+      m_gscale++;
+    }
+    return m_gscale;
+  }
+
+  if (peak >= m_settings.lower_threshold ||
+      m_gscale <= m_settings.minimum_gscale) {
+    m_quiet_samples = 0;
+    return m_gscale;
+  }
+
+  m_quiet_samples++;
+  if (m_quiet_samples >= m_settings.hold_samples) {
+    m_quiet_samples = 0;
+    m_gscale--;
+  }
+
+  return m_gscale;
+}
+}  // namespace hal::mpu
@@ -1,121 +1,265 @@
-#include "lis3dhtr_constants.hpp"
+#include <cmath>
+
 #include <libhal-mpu/lis3dhtr.hpp>
 #include <libhal-util/bit.hpp>
-#include <libhal-util/serial.hpp>
-#include <libhal-util/steady_clock.hpp>
-#include <libhal/serial.hpp>
+#include <libhal-util/i2c.hpp>
+#include <libhal/error.hpp>
 
 namespace hal::mpu {
-using namespace std::chrono_literals;
-using namespace hal::literals;
-result<lis3dhtr> lis3dhtr::create(hal::i2c& p_i2c,
-                                  hal::serial& p_console,
-                                  hal::steady_clock* clock,
-                                  hal::byte p_device_address)
+namespace {
+template<hal::bit_mask field>
+void modify_register(hal::i2c& p_i2c,
+                     hal::byte p_address,
+                     hal::byte p_register,
+                     hal::byte p_value)
+{
+  auto value = hal::write_then_read<1>(
+    p_i2c, p_address, std::array{ p_register }, hal::never_timeout())[0];
+
+  hal::bit_modify(value).template insert<field>(p_value);
+
+  hal::write(
+    p_i2c, p_address, std::array{ p_register, value }, hal::never_timeout());
+}
+
+// the largest value the 7-bit threshold and duration fields can hold
+constexpr hal::byte max_event_field = 0x7F;
+
+template<class Traits>
+hal::byte to_event_threshold(float p_threshold,
+                             hal::byte p_gscale,
+                             void* p_instance)
+{
+  const auto g_per_lsb = Traits::event_g_per_lsb[p_gscale & 0b11];
+  const auto counts = std::lround(p_threshold / g_per_lsb);
+  if (counts < 0 || counts > max_event_field) {
+    hal::safe_throw(hal::argument_out_of_domain(p_instance));
+  }
+  return static_cast<hal::byte>(counts);
+}
+
+hal::byte to_event_samples(hal::byte p_samples, void* p_instance)
 {
-  lis3dhtr lis(p_i2c, p_device_address);
-  HAL_CHECK(lis.power_on(p_console, clock));
-  return lis;
+  if (p_samples > max_event_field) {
+    hal::safe_throw(hal::argument_out_of_domain(p_instance));
+  }
+  return p_samples;
 }
+}  // namespace
 
-lis3dhtr::lis3dhtr(hal::i2c& p_i2c, hal::byte p_device_address)
+template<class Traits>
+basic_lis<Traits>::basic_lis(hal::i2c& p_i2c, hal::byte p_device_address)
   : m_i2c(&p_i2c)
   , m_address(p_device_address)
 {
+  auto device_id =
+    hal::write_then_read<1>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::who_am_i_register },
+                            hal::never_timeout())[0];
+
+  if (device_id != Traits::device_id) {
+    hal::safe_throw(hal::no_such_device(m_address, this));
+  }
+
+  power_on();
 }
 
-hal::result<accelerometer::read_t> lis3dhtr::driver_read()
+template<class Traits>
+accelerometer::read_t basic_lis<Traits>::driver_read()
 {
-  accelerometer::read_t acceleration;
-  constexpr auto number_of_axis = 3;
-  constexpr auto bytes_per_axis = 2;
-  auto xyz_acceleration =
-    HAL_CHECK(hal::write_then_read<number_of_axis * bytes_per_axis>(
-      *m_i2c,
-      m_address,
-      std::array{ hal::mpu::read_xyz_axis },
-      hal::never_timeout()));
-  // parsing data from accelerometer
-  /**
-   all data is left justified which means the data will always have the lowest
-   nibble be 0 so we shift it all to the right by 4 and or the low and high
-   bytes together 0000'0000'0000'0000
-  */
-  int16_t x = static_cast<uint16_t>(xyz_acceleration[0]) |
-              ((static_cast<uint16_t>(xyz_acceleration[1])) << 8);
-  int16_t y = static_cast<uint16_t>(xyz_acceleration[2]) |
-              ((static_cast<uint16_t>(xyz_acceleration[3])) << 8);
-  int16_t z = static_cast<uint16_t>(xyz_acceleration[4]) |
-              ((static_cast<uint16_t>(xyz_acceleration[5])) << 8);
-
-  constexpr float max = static_cast<float>(std::numeric_limits<int16_t>::max());
-  constexpr float min = static_cast<float>(std::numeric_limits<int16_t>::min());
-
-  float output_limits =
-    static_cast<float>(1 << (static_cast<int16_t>(m_gscale) + 1));
-  auto input_range = std::make_pair(max, min);
-  auto output_range = std::make_pair(-output_limits, output_limits);
-
-  acceleration.x = hal::map(x, input_range, output_range);
-  acceleration.y = hal::map(y, input_range, output_range);
-  acceleration.z = hal::map(z, input_range, output_range);
-
-  return acceleration;
+  return to_read_t(read_raw());
 }
 
-hal::status lis3dhtr::power_on(hal::serial& p_console, hal::steady_clock* clock)
+template<class Traits>
+void basic_lis<Traits>::power_on()
 {
-  HAL_CHECK(configure_data_rates(data_rate_configs::mode_7, p_console, clock));
-  return hal::success();
+  configure_data_rates(data_rate_configs::mode_7);
 }
 
-hal::status lis3dhtr::power_off(hal::serial& p_console,
-                                hal::steady_clock* clock)
+template<class Traits>
+void basic_lis<Traits>::power_off()
 {
-  HAL_CHECK(configure_data_rates(data_rate_configs::mode_0, p_console, clock));
-  return hal::success();
+  configure_data_rates(data_rate_configs::mode_0);
 }
 
-hal::status lis3dhtr::configure_data_rates(data_rate_configs p_data_rate,
-                                           hal::serial& p_console,
-                                           hal::steady_clock* clock)
+template<class Traits>
+void basic_lis<Traits>::configure_data_rates(data_rate_configs p_data_rate)
 {
-
   constexpr auto configure_reg_bit_mask = hal::bit_mask::from<7, 4>();
-  auto ctrl_reg1_array = std::array{ ctrl_reg1 };
-  auto ctrl_reg1_data = HAL_CHECK(hal::write_then_read<1>(
-    *m_i2c, m_address, ctrl_reg1_array, hal::never_timeout()));
-  (void)hal::delay(*clock, 10ms);
 
-  hal::bit_modify(ctrl_reg1_data[0])
-    .insert<configure_reg_bit_mask>(static_cast<hal::byte>(p_data_rate));
-
-  HAL_CHECK(hal::write(*m_i2c,
-                       m_address,
-                       std::array{ ctrl_reg1, ctrl_reg1_data[0] },
-                       hal::never_timeout()));
-  return hal::success();
+  modify_register<configure_reg_bit_mask>(*m_i2c,
+                                          m_address,
+                                          Traits::ctrl_reg1,
+                                          static_cast<hal::byte>(p_data_rate));
 }
 
-hal::status lis3dhtr::configure_full_scale(max_acceleration p_gravity_code,
-                                           hal::steady_clock* clock)
+template<class Traits>
+void basic_lis<Traits>::configure_full_scale(max_acceleration p_gravity_code)
 {
+  constexpr auto configure_reg_bit_mask = hal::bit_mask::from<5, 4>();
 
   m_gscale = static_cast<hal::byte>(p_gravity_code);
 
-  constexpr auto configure_reg_bit_mask = hal::bit_mask::from<5, 4>();
-  auto ctrl_reg4_array = std::array{ ctrl_reg4 };
-  auto ctrl_reg4_data = HAL_CHECK(hal::write_then_read<1>(
-    *m_i2c, m_address, ctrl_reg4_array, hal::never_timeout()));
-  (void)hal::delay(*clock, 10ms);
-  hal::bit_modify(ctrl_reg4_data[0])
-    .insert<configure_reg_bit_mask>(static_cast<hal::byte>(p_gravity_code));
-
-  HAL_CHECK(hal::write(*m_i2c,
+  modify_register<configure_reg_bit_mask>(
+    *m_i2c, m_address, Traits::ctrl_reg4, m_gscale);
+}
+
+template<class Traits>
+void basic_lis<Traits>::configure_events(const event_settings& p_settings)
+{
+  constexpr auto high_pass_click_mask = hal::bit_mask::from<2>();
+  constexpr auto high_pass_ia1_mask = hal::bit_mask::from<0>();
+  // I1_CLICK, I1_IA1 and I1_IA2 in that order from the MSb
+  constexpr auto int1_routing_mask = hal::bit_mask::from<5, 7>();
+  constexpr auto latch_mask = hal::bit_mask::from<1, 3>();
+  constexpr auto polarity_mask = hal::bit_mask::from<1>();
+  constexpr hal::byte route_click = 0b100;
+  constexpr hal::byte route_ia1 = 0b010;
+  constexpr hal::byte route_ia2 = 0b001;
+  // LIR_INT1 and LIR_INT2, with the 4D detection bit between them left off
+  constexpr hal::byte latch_both = 0b101;
+  // any of X, Y or Z high
+  constexpr hal::byte or_of_high_events = 0b0010'1010;
+  // all of X, Y and Z low
+  constexpr hal::byte and_of_low_events = 0b1001'0101;
+  constexpr hal::byte single_click_xyz = 0b0001'0101;
+  constexpr hal::byte double_click_xyz = 0b0010'1010;
+  constexpr hal::byte latch_click = 0b1000'0000;
+  constexpr hal::byte auto_increment = Traits::auto_increment;
+
+  hal::byte routing = 0;
+  hal::byte int1_config = 0;
+  hal::byte int2_config = 0;
+  hal::byte click_config = 0;
+
+  if (p_settings.motion) {
+    const auto threshold = to_event_threshold<Traits>(
+      p_settings.motion->threshold, m_gscale, this);
+    const auto duration = to_event_samples(p_settings.motion->duration, this);
+    hal::write(*m_i2c,
+               m_address,
+               std::array{ static_cast<hal::byte>(Traits::int1_ths |
+                                                  auto_increment),
+                           threshold,
+                           duration },
+               hal::never_timeout());
+    int1_config = or_of_high_events;
+    routing |= route_ia1;
+  }
+
+  if (p_settings.free_fall) {
+    const auto threshold = to_event_threshold<Traits>(
+      p_settings.free_fall->threshold, m_gscale, this);
+    const auto duration =
+      to_event_samples(p_settings.free_fall->duration, this);
+    hal::write(*m_i2c,
+               m_address,
+               std::array{ static_cast<hal::byte>(Traits::int2_ths |
+                                                  auto_increment),
+                           threshold,
+                           duration },
+               hal::never_timeout());
+    int2_config = and_of_low_events;
+    routing |= route_ia2;
+  }
+
+  if (p_settings.click) {
+    const auto& click = *p_settings.click;
+    auto threshold =
+      to_event_threshold<Traits>(click.threshold, m_gscale, this);
+    const auto limit = to_event_samples(click.time_limit, this);
+    if (p_settings.latch) {
+      threshold |= latch_click;
+    }
+    hal::write(
+      *m_i2c,
+      m_address,
+      std::array{ static_cast<hal::byte>(Traits::click_ths | auto_increment),
+                  threshold,
+                  limit,
+                  click.time_latency,
+                  click.time_window },
+      hal::never_timeout());
+    click_config = click.double_click ? double_click_xyz : single_click_xyz;
+    routing |= route_click;
+  }
+
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::int1_cfg, int1_config },
+             hal::never_timeout());
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::int2_cfg, int2_config },
+             hal::never_timeout());
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::click_cfg, click_config },
+             hal::never_timeout());
+
+  modify_register<high_pass_ia1_mask>(
+    *m_i2c, m_address, Traits::ctrl_reg2, p_settings.motion.has_value());
+  modify_register<high_pass_click_mask>(
+    *m_i2c, m_address, Traits::ctrl_reg2, p_settings.click.has_value());
+  modify_register<int1_routing_mask>(
+    *m_i2c, m_address, Traits::ctrl_reg3, routing);
+  modify_register<latch_mask>(
+    *m_i2c, m_address, Traits::ctrl_reg5, p_settings.latch ? latch_both : 0);
+  modify_register<polarity_mask>(
+    *m_i2c, m_address, Traits::ctrl_reg6, p_settings.active_low);
+
+  if (p_settings.motion) {
+    // Reading the reference register sets the high pass filter to the current
+    // acceleration so that gravity does not immediately count as motion.
+    hal::write_then_read<1>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::reference_reg },
+                            hal::never_timeout());
+  }
+}
+
+template<class Traits>
+typename basic_lis<Traits>::events_t basic_lis<Traits>::read_events()
+{
+  constexpr auto active_mask = hal::bit_mask::from<6>();
+  constexpr auto x_high_mask = hal::bit_mask::from<1>();
+  constexpr auto y_high_mask = hal::bit_mask::from<3>();
+  constexpr auto z_high_mask = hal::bit_mask::from<5>();
+  constexpr auto single_click_mask = hal::bit_mask::from<4>();
+  constexpr auto double_click_mask = hal::bit_mask::from<5>();
+  constexpr std::size_t int1_source = 0;
+  constexpr std::size_t int2_source = Traits::int2_src - Traits::int1_src;
+  constexpr std::size_t click_source = Traits::click_src - Traits::int1_src;
+
+  // INT1_SRC through CLICK_SRC in one go, reading the source registers also
+  // clears any latched interrupts.
+  std::array<hal::byte, click_source + 1> sources;
+  hal::write_then_read(*m_i2c,
                        m_address,
-                       std::array{ ctrl_reg4, ctrl_reg4_data[0] },
-                       hal::never_timeout()));
-  return hal::success();
+                       std::array{ static_cast<hal::byte>(
+                         Traits::int1_src | Traits::auto_increment) },
+                       sources,
+                       hal::never_timeout());
+
+  events_t events{
+    .motion = hal::bit_extract<active_mask>(sources[int1_source]) != 0,
+    .free_fall = hal::bit_extract<active_mask>(sources[int2_source]) != 0,
+    .click =
+      hal::bit_extract<single_click_mask>(sources[click_source]) != 0,
+    .double_click =
+      hal::bit_extract<double_click_mask>(sources[click_source]) != 0,
+  };
+
+  if (events.motion) {
+    events.motion_x = hal::bit_extract<x_high_mask>(sources[int1_source]) != 0;
+    events.motion_y = hal::bit_extract<y_high_mask>(sources[int1_source]) != 0;
+    events.motion_z = hal::bit_extract<z_high_mask>(sources[int1_source]) != 0;
+  }
+
+  return events;
 }
 
-}  // namespace hal::mpu
\ No newline at end of file
+template class basic_lis<lis3dh_traits>;
+template class basic_lis<lis2dh12_traits>;
+}  // namespace hal::mpu
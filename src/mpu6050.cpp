@@ -12,6 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <utility>
+
 #include <libhal-mpu/mpu6050.hpp>
 #include <libhal-util/bit.hpp>
 #include <libhal-util/i2c.hpp>
@@ -19,12 +25,11 @@
 #include <libhal/accelerometer.hpp>
 #include <libhal/error.hpp>
 
-#include "mpu6050_constants.hpp"
-
 namespace hal::mpu {
 
 namespace {
 
+template<class Traits>
 void active_mode(hal::i2c& p_i2c, hal::byte p_address, bool p_is_active)
 {
   constexpr auto sleep_mask = hal::bit_mask::from<6>();
@@ -32,116 +37,698 @@ void active_mode(hal::i2c& p_i2c, hal::byte p_address, bool p_is_active)
   auto control =
     hal::write_then_read<1>(p_i2c,
                             p_address,
-                            std::array{ hal::mpu::initalizing_register },
+                            std::array{ Traits::initalizing_register },
                             hal::never_timeout())[0];
 
-  hal::bit_modify(control).insert<sleep_mask>(!p_is_active);
+  hal::bit_modify(control).template insert<sleep_mask>(!p_is_active);
 
   hal::write(p_i2c,
              p_address,
-             std::array{ hal::mpu::initalizing_register, control },
+             std::array{ Traits::initalizing_register, control },
              hal::never_timeout());
 }
+
+/**
+ * @brief Read a register, replace one field within it and write it back
+ *
+ * @tparam field - bits of the register to replace
+ * @param p_i2c - bus the device is on
+ * @param p_address - device address
+ * @param p_register - register to modify
+ * @param p_value - new value of the field
+ * @return hal::byte - the value written to the register
+ */
+template<hal::bit_mask field>
+hal::byte modify_register(hal::i2c& p_i2c,
+                          hal::byte p_address,
+                          hal::byte p_register,
+                          hal::byte p_value)
+{
+  auto value = hal::write_then_read<1>(
+    p_i2c, p_address, std::array{ p_register }, hal::never_timeout())[0];
+
+  hal::bit_modify(value).template insert<field>(p_value);
+
+  hal::write(
+    p_i2c, p_address, std::array{ p_register, value }, hal::never_timeout());
+
+  return value;
+}
+
+/**
+ * @brief Disable the FIFO and discard its contents
+ *
+ * The FIFO only resets while it is disabled, and the reset bit clears itself.
+ * The caller enables it again once ready.
+ */
+template<class Traits>
+void reset_fifo(hal::i2c& p_i2c, hal::byte p_address)
+{
+  constexpr auto fifo_mask = hal::bit_mask::from<6>();
+  constexpr auto fifo_reset_mask = hal::bit_mask::from<2>();
+  constexpr auto user_control = Traits::user_control_register;
+
+  modify_register<fifo_mask>(p_i2c, p_address, user_control, 0U);
+  modify_register<fifo_reset_mask>(p_i2c, p_address, user_control, 1U);
+}
+
+/**
+ * @brief Discard the contents of an enabled FIFO and keep buffering
+ */
+template<class Traits>
+void restart_fifo(hal::i2c& p_i2c, hal::byte p_address)
+{
+  constexpr auto fifo_mask = hal::bit_mask::from<6>();
+
+  reset_fifo<Traits>(p_i2c, p_address);
+  modify_register<fifo_mask>(
+    p_i2c, p_address, Traits::user_control_register, 1U);
+}
+
+/**
+ * @brief Convert an event threshold in g into its register value
+ *
+ * @param p_threshold - threshold in g
+ * @param p_g_per_lsb - acceleration represented by one LSB of the register
+ * @param p_instance - driver reporting the error
+ * @return hal::byte - threshold in units of `p_g_per_lsb`
+ * @throws hal::argument_out_of_domain - when the threshold cannot be
+ * represented.
+ */
+hal::byte to_event_threshold(float p_threshold,
+                             float p_g_per_lsb,
+                             void* p_instance)
+{
+  const auto counts = std::lround(p_threshold / p_g_per_lsb);
+
+  if (counts < 0 || counts > std::numeric_limits<hal::byte>::max()) {
+    hal::safe_throw(hal::argument_out_of_domain(p_instance));
+  }
+
+  return static_cast<hal::byte>(counts);
+}
+
+/**
+ * @brief Convert an event duration into its register value
+ *
+ * @param p_duration - duration of the event
+ * @param p_instance - driver reporting the error
+ * @return hal::byte - duration in units of 1ms
+ * @throws hal::argument_out_of_domain - when the duration cannot be
+ * represented.
+ */
+hal::byte to_event_duration(hal::time_duration p_duration, void* p_instance)
+{
+  const auto milliseconds =
+    std::chrono::duration_cast<std::chrono::milliseconds>(p_duration).count();
+
+  if (milliseconds < 0 ||
+      milliseconds > std::numeric_limits<hal::byte>::max()) {
+    hal::safe_throw(hal::argument_out_of_domain(p_instance));
+  }
+
+  return static_cast<hal::byte>(milliseconds);
+}
 }  // namespace
 
-mpu6050::mpu6050(hal::i2c& p_i2c, hal::byte p_device_address)
+template<class Traits>
+basic_mpu<Traits>::basic_mpu(hal::i2c& p_i2c, hal::byte p_device_address)
   : m_i2c(&p_i2c)
   , m_address(p_device_address)
 {
-  static constexpr hal::byte expected_device_id = 0x68;
   // Read out the identity register
   auto device_id =
     hal::write_then_read<1>(*m_i2c,
                             m_address,
-                            std::array{ hal::mpu::who_am_i_register },
+                            std::array{ Traits::who_am_i_register },
                             hal::never_timeout())[0];
 
-  if (device_id != expected_device_id) {
+  if (device_id != Traits::device_id) {
     hal::safe_throw(hal::no_such_device(m_address, this));
   }
 
   power_on();
 }
 
-void mpu6050::configure_full_scale(max_acceleration p_gravity_code)
+template<class Traits>
+bool basic_mpu<Traits>::probe(hal::i2c& p_i2c, hal::byte p_address)
+{
+  std::array<hal::byte, 1> device_id{};
+
+  try {
+    hal::write_then_read(p_i2c,
+                         p_address,
+                         std::array{ Traits::who_am_i_register },
+                         device_id,
+                         hal::never_timeout());
+  } catch (const hal::no_such_device&) {
+    return false;
+  }
+
+  return device_id[0] == Traits::device_id;
+}
+
+template<class Traits>
+void basic_mpu<Traits>::configure_full_scale(max_acceleration p_gravity_code)
 {
   constexpr auto scale_mask = hal::bit_mask::from<3, 4>();
 
+  const auto previous_gscale = m_gscale;
   m_gscale = static_cast<hal::byte>(p_gravity_code);
 
-  auto config = hal::write_then_read<1>(*m_i2c,
-                                        m_address,
-                                        std::array{ configuration_register },
-                                        hal::never_timeout())[0];
+  auto config =
+    hal::write_then_read<1>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::configuration_register },
+                            hal::never_timeout())[0];
+
+  hal::bit_modify(config).template insert<scale_mask>(m_gscale);
+
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::configuration_register, config },
+             hal::never_timeout());
+
+  m_accel_config = config;
+
+  if (m_gscale != previous_gscale) {
+    begin_scale_change(previous_gscale);
+  }
+
+  if (m_auto_range) {
+    m_auto_range->gscale(m_gscale);
+  }
+}
+
+template<class Traits>
+void basic_mpu<Traits>::enable_auto_range(auto_range::settings p_settings)
+{
+  m_auto_range.emplace(p_settings, m_gscale);
+  // Bring the device to the scale the engine starts from (it may have been
+  // clamped into the allowed range) and seed the cached register value.
+  configure_full_scale(static_cast<max_acceleration>(m_auto_range->gscale()));
+}
+
+template<class Traits>
+void basic_mpu<Traits>::disable_auto_range()
+{
+  m_auto_range.reset();
+}
+
+template<class Traits>
+void basic_mpu<Traits>::configure_events(const event_settings& p_settings)
+{
+  constexpr auto high_pass_mask = hal::bit_mask::from<0, 2>();
+  constexpr auto active_low_mask = hal::bit_mask::from<7>();
+  constexpr auto latch_mask = hal::bit_mask::from<5>();
+  constexpr auto clear_on_any_read_mask = hal::bit_mask::from<4>();
+  constexpr auto free_fall_enable_mask = hal::bit_mask::from<7>();
+  constexpr auto motion_enable_mask = hal::bit_mask::from<6>();
+  constexpr auto data_ready_enable_mask = hal::bit_mask::from<0>();
+  // 5Hz cut off, removes gravity while keeping the movements of handling
+  constexpr hal::byte high_pass_5hz = 0b001;
+  constexpr hal::byte high_pass_reset = 0b000;
+  // ACCEL_INTEL_EN, and compare each sample against the previous one
+  constexpr hal::byte wake_on_motion_enable = 0b1100'0000;
+
+  if (p_settings.motion && p_settings.free_fall) {
+    hal::safe_throw(hal::argument_out_of_domain(this));
+  }
+
+  hal::byte enable = 0;
+  hal::byte high_pass = high_pass_reset;
+
+  if (p_settings.motion) {
+    const auto threshold = to_event_threshold(
+      p_settings.motion->threshold, Traits::motion_g_per_lsb, this);
+    if constexpr (Traits::wake_on_motion) {
+      hal::write(*m_i2c,
+                 m_address,
+                 std::array{ Traits::motion_threshold_register, threshold },
+                 hal::never_timeout());
+    } else {
+      const auto duration =
+        to_event_duration(p_settings.motion->duration, this);
+      // The duration register directly follows the threshold register
+      hal::write(
+        *m_i2c,
+        m_address,
+        std::array{ Traits::motion_threshold_register, threshold, duration },
+        hal::never_timeout());
+    }
+    hal::bit_modify(enable).template set<motion_enable_mask>();
+    high_pass = high_pass_5hz;
+  }
+
+  if constexpr (Traits::wake_on_motion) {
+    if (p_settings.free_fall) {
+      hal::safe_throw(hal::argument_out_of_domain(this));
+    }
+  } else if (p_settings.free_fall) {
+    const auto threshold = to_event_threshold(
+      p_settings.free_fall->threshold, Traits::motion_g_per_lsb, this);
+    const auto duration =
+      to_event_duration(p_settings.free_fall->duration, this);
+    hal::write(
+      *m_i2c,
+      m_address,
+      std::array{ Traits::free_fall_threshold_register, threshold, duration },
+      hal::never_timeout());
+    hal::bit_modify(enable).template set<free_fall_enable_mask>();
+  }
+
+  if (p_settings.data_ready) {
+    hal::bit_modify(enable).template set<data_ready_enable_mask>();
+  }
+
+  if constexpr (Traits::wake_on_motion) {
+    // Wake on motion has no high pass filter setting, it is switched on as a
+    // whole instead.
+    hal::write(*m_i2c,
+               m_address,
+               std::array{ Traits::accel_intelligence_control_register,
+                           p_settings.motion ? wake_on_motion_enable
+                                             : hal::byte{ 0 } },
+               hal::never_timeout());
+  } else {
+    auto accel_config =
+      hal::write_then_read<1>(*m_i2c,
+                              m_address,
+                              std::array{ Traits::configuration_register },
+                              hal::never_timeout())[0];
+    hal::bit_modify(accel_config).template insert<high_pass_mask>(high_pass);
+    hal::write(*m_i2c,
+               m_address,
+               std::array{ Traits::configuration_register, accel_config },
+               hal::never_timeout());
+    m_accel_config = accel_config;
+  }
+
+  auto pin_config =
+    hal::write_then_read<1>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::interrupt_pin_config_register },
+                            hal::never_timeout())[0];
+  hal::bit_modify(pin_config)
+    .template insert<active_low_mask>(p_settings.active_low)
+    .template insert<latch_mask>(p_settings.latch)
+    .template clear<clear_on_any_read_mask>();
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::interrupt_pin_config_register, pin_config },
+             hal::never_timeout());
+
+  m_interrupt_enable = enable;
+  write_interrupt_enable();
+}
+
+template<class Traits>
+typename basic_mpu<Traits>::events_t basic_mpu<Traits>::read_events()
+{
+  constexpr auto free_fall_mask = hal::bit_mask::from<7>();
+  constexpr auto motion_mask = hal::bit_mask::from<6>();
+  constexpr auto fifo_overflow_mask = hal::bit_mask::from<4>();
+  constexpr auto data_ready_mask = hal::bit_mask::from<0>();
+  constexpr auto motion_x_mask = hal::bit_mask::from<6, 7>();
+  constexpr auto motion_y_mask = hal::bit_mask::from<4, 5>();
+  constexpr auto motion_z_mask = hal::bit_mask::from<2, 3>();
+
+  const auto status =
+    read_interrupt_status() | std::exchange(m_missed_status, 0);
+
+  events_t events{
+    .motion = hal::bit_extract<motion_mask>(status) != 0,
+    .free_fall = hal::bit_extract<free_fall_mask>(status) != 0,
+    .data_ready = hal::bit_extract<data_ready_mask>(status) != 0,
+    .fifo_overflow = hal::bit_extract<fifo_overflow_mask>(status) != 0,
+  };
+
+  if constexpr (!Traits::wake_on_motion) {
+    if (events.motion) {
+      const auto axes = hal::write_then_read<1>(
+        *m_i2c,
+        m_address,
+        std::array{ Traits::motion_detect_status_register },
+        hal::never_timeout())[0];
+      events.motion_x = hal::bit_extract<motion_x_mask>(axes) != 0;
+      events.motion_y = hal::bit_extract<motion_y_mask>(axes) != 0;
+      events.motion_z = hal::bit_extract<motion_z_mask>(axes) != 0;
+    }
+  }
+
+  return events;
+}
+
+template<class Traits>
+void basic_mpu<Traits>::power_on()
+{
+  return active_mode<Traits>(*m_i2c, m_address, true);
+}
+
+template<class Traits>
+void basic_mpu<Traits>::power_off()
+{
+  return active_mode<Traits>(*m_i2c, m_address, false);
+}
+
+template<class Traits>
+hal::time_duration basic_mpu<Traits>::configure_power(
+  const power_profile& p_profile)
+{
+  constexpr auto cycle_mask = hal::bit_mask::from<5>();
+  constexpr auto temperature_disable_mask = hal::bit_mask::from<3>();
+  constexpr auto wake_control_mask = hal::bit_mask::from<6, 7>();
+  constexpr auto standby_x_accel_mask = hal::bit_mask::from<5>();
+  constexpr auto standby_y_accel_mask = hal::bit_mask::from<4>();
+  constexpr auto standby_z_accel_mask = hal::bit_mask::from<3>();
+  constexpr auto standby_gyro_mask = hal::bit_mask::from<0, 2>();
+  constexpr hal::byte all_gyro_axes = 0b111;
+
+  if (p_profile.cycle && p_profile.gyroscope) {
+    hal::safe_throw(hal::argument_out_of_domain(this));
+  }
+
+  const auto rate =
+    static_cast<hal::byte>(p_profile.cycle.value_or(wake_rate::hz1_25));
+  const hal::byte gyro_standby = p_profile.gyroscope ? 0 : all_gyro_axes;
+
+  hal::byte standby = 0;
+  hal::bit_modify(standby)
+    .template insert<standby_x_accel_mask>(!p_profile.accelerometer_x)
+    .template insert<standby_y_accel_mask>(!p_profile.accelerometer_y)
+    .template insert<standby_z_accel_mask>(!p_profile.accelerometer_z)
+    .template insert<standby_gyro_mask>(gyro_standby);
+
+  if constexpr (Traits::cycle_rate_in_power_management_2) {
+    hal::bit_modify(standby).template insert<wake_control_mask>(rate);
+  } else {
+    hal::write(*m_i2c,
+               m_address,
+               std::array{ Traits::low_power_rate_register,
+                           Traits::cycle_rate_codes[rate] },
+               hal::never_timeout());
+  }
+
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::power_management_2_register, standby },
+             hal::never_timeout());
+
+  // Cycling starts once the standby bits are in place, so that the gyroscope
+  // is never woken up by it.
+  auto control =
+    hal::write_then_read<1>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::initalizing_register },
+                            hal::never_timeout())[0];
+  hal::bit_modify(control)
+    .template insert<cycle_mask>(p_profile.cycle.has_value())
+    .template insert<temperature_disable_mask>(!p_profile.temperature);
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::initalizing_register, control },
+             hal::never_timeout());
+
+  return wake_up_latency(p_profile);
+}
+
+template<class Traits>
+void basic_mpu<Traits>::apply_auto_range(const raw_acceleration& p_sample)
+{
+  constexpr auto scale_mask = hal::bit_mask::from<3, 4>();
+  const auto next_gscale = m_auto_range->update(p_sample);
+
+  if (next_gscale != m_gscale) {
+    const auto previous_gscale = m_gscale;
+    m_gscale = next_gscale;
+    hal::bit_modify(m_accel_config).template insert<scale_mask>(m_gscale);
+    hal::write(*m_i2c,
+               m_address,
+               std::array{ Traits::configuration_register, m_accel_config },
+               hal::never_timeout());
+    begin_scale_change(previous_gscale);
+  }
+}
+
+template<class Traits>
+void basic_mpu<Traits>::begin_scale_change(hal::byte p_previous_gscale)
+{
+  // The output registers keep the sample captured at the previous scale until
+  // the next accelerometer update. Reading INT_STATUS clears DATA_RDY, so the
+  // next time it is set the registers hold a sample at the new scale. A
+  // DATA_RDY seen here ends an earlier change that was still settling, whose
+  // new scale is the previous one of this change.
+  read_interrupt_status();
+  if (!m_scale_settling) {
+    m_previous_gscale = p_previous_gscale;
+    m_scale_settling = true;
+    write_interrupt_enable();
+  }
+
+  if (m_fifo_enabled) {
+    // Frames already in the FIFO were captured at the previous scale and
+    // would be tagged with the new one when drained.
+    restart_fifo<Traits>(*m_i2c, m_address);
+    m_fifo_overflowed = false;
+  }
+}
 
-  hal::bit_modify(config).insert<scale_mask>(m_gscale);
+template<class Traits>
+hal::byte basic_mpu<Traits>::read_interrupt_status()
+{
+  const auto status =
+    hal::write_then_read<1>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::interrupt_status_register },
+                            hal::never_timeout())[0];
+  track_interrupt_status(status);
+  return status;
+}
+
+template<class Traits>
+void basic_mpu<Traits>::track_interrupt_status(hal::byte p_status)
+{
+  constexpr auto data_ready_mask = hal::bit_mask::from<0>();
+  constexpr auto fifo_overflow_mask = hal::bit_mask::from<4>();
+
+  if (m_scale_settling && hal::bit_extract<data_ready_mask>(p_status) != 0) {
+    // A sample was captured since the last read, so the output registers
+    // hold one at the current scale.
+    m_scale_settling = false;
+    write_interrupt_enable();
+  }
+  if (hal::bit_extract<fifo_overflow_mask>(p_status) != 0) {
+    m_fifo_overflowed = true;
+  }
+
+  // DATA_RDY would be stale by the time `read_events()` reports it
+  hal::bit_modify(p_status).template clear<data_ready_mask>();
+  m_missed_status |= p_status;
+}
+
+template<class Traits>
+void basic_mpu<Traits>::write_interrupt_enable()
+{
+  constexpr auto data_ready_enable_mask = hal::bit_mask::from<0>();
+
+  auto enable = m_interrupt_enable;
+  if (m_scale_settling) {
+    // DATA_RDY is only set in INT_STATUS while its interrupt is enabled, and
+    // it is what ends the wait for a sample at the new scale.
+    hal::bit_modify(enable).template set<data_ready_enable_mask>();
+  }
 
   hal::write(*m_i2c,
              m_address,
-             std::array{ configuration_register, config },
+             std::array{ Traits::interrupt_enable_register, enable },
              hal::never_timeout());
 }
 
-void mpu6050::power_on()
+template<class Traits>
+hal::byte basic_mpu<Traits>::read_output_after_scale_change(
+  std::span<hal::byte> p_data)
 {
-  return active_mode(*m_i2c, m_address, true);
+  constexpr std::size_t status_bytes = 1;
+
+  // INT_STATUS sits right before the output registers, so it is read in the
+  // same transaction as the data it describes.
+  std::array<hal::byte, status_bytes + bytes_per_sample + 2> buffer;
+  const auto status_and_data =
+    std::span(buffer).first(status_bytes + p_data.size());
+  hal::write_then_read(*m_i2c,
+                       m_address,
+                       std::array{ Traits::interrupt_status_register },
+                       status_and_data,
+                       hal::never_timeout());
+  std::ranges::copy(status_and_data.subspan(status_bytes), p_data.begin());
+
+  track_interrupt_status(buffer[0]);
+
+  return m_scale_settling ? m_previous_gscale : m_gscale;
 }
 
-void mpu6050::power_off()
+template<class Traits>
+hal::hertz basic_mpu<Traits>::configure_sample_rate(hal::hertz p_rate)
 {
-  return active_mode(*m_i2c, m_address, false);
+  constexpr auto low_pass_mask = hal::bit_mask::from<0, 2>();
+  constexpr hal::byte low_pass_184hz = 1;
+  constexpr float internal_rate = 1000.0f;
+
+  if (!(p_rate > 0.0f)) {
+    hal::safe_throw(hal::argument_out_of_domain(this));
+  }
+
+  // Clamped before rounding, a very low rate would not fit in a 32-bit long
+  constexpr float max_divisions = 256.0f;
+  const auto divisions =
+    std::clamp(internal_rate / p_rate, 1.0f, max_divisions);
+  const auto divider = std::lround(divisions) - 1;
+
+  modify_register<low_pass_mask>(
+    *m_i2c, m_address, Traits::config_register, low_pass_184hz);
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::sample_rate_divider_register,
+                         static_cast<hal::byte>(divider) },
+             hal::never_timeout());
+
+  return internal_rate / static_cast<float>(divider + 1);
 }
 
-accelerometer::read_t mpu6050::driver_read()
+template<class Traits>
+void basic_mpu<Traits>::enable_fifo()
+{
+  constexpr auto fifo_mask = hal::bit_mask::from<6>();
+  constexpr hal::byte accelerometer_only = 1 << 3;
+  constexpr auto user_control = Traits::user_control_register;
+
+  reset_fifo<Traits>(*m_i2c, m_address);
+  m_fifo_overflowed = false;
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::fifo_enable_register, accelerometer_only },
+             hal::never_timeout());
+  modify_register<fifo_mask>(*m_i2c, m_address, user_control, 1U);
+  m_fifo_enabled = true;
+}
+
+template<class Traits>
+void basic_mpu<Traits>::disable_fifo()
+{
+  constexpr auto fifo_mask = hal::bit_mask::from<6>();
+
+  modify_register<fifo_mask>(
+    *m_i2c, m_address, Traits::user_control_register, 0U);
+  hal::write(*m_i2c,
+             m_address,
+             std::array{ Traits::fifo_enable_register, hal::byte{ 0 } },
+             hal::never_timeout());
+  m_fifo_enabled = false;
+}
+
+template<class Traits>
+std::size_t basic_mpu<Traits>::fifo_sample_count()
+{
+  const auto count =
+    hal::write_then_read<2>(*m_i2c,
+                            m_address,
+                            std::array{ Traits::fifo_count_register },
+                            hal::never_timeout());
+  const auto bytes = static_cast<std::size_t>(count[0] << 8 | count[1]);
+  return bytes / bytes_per_sample;
+}
+
+template<class Traits>
+typename basic_mpu<Traits>::fifo_view basic_mpu<Traits>::read_fifo_frames(
+  std::span<hal::byte> p_buffer,
+  std::size_t p_frames)
+{
+  const auto bytes = p_buffer.first(p_frames * bytes_per_sample);
+
+  if (!bytes.empty()) {
+    hal::write_then_read(*m_i2c,
+                         m_address,
+                         std::array{ Traits::fifo_data_register },
+                         bytes,
+                         hal::never_timeout());
+  }
+
+  return { bytes, m_gscale };
+}
+
+template<class Traits>
+void basic_mpu<Traits>::check_fifo_overflow()
+{
+  constexpr auto fifo_overflow_mask = hal::bit_mask::from<4>();
+
+  read_interrupt_status();
+
+  if (m_fifo_overflowed) {
+    // FIFO_COUNT is not a multiple of a sample once the oldest bytes have
+    // been overwritten, so nothing in the FIFO can be decoded reliably.
+    restart_fifo<Traits>(*m_i2c, m_address);
+    m_fifo_overflowed = false;
+    // The exception reports the overflow, `read_events()` does not repeat it
+    hal::bit_modify(m_missed_status).template clear<fifo_overflow_mask>();
+    hal::safe_throw(hal::io_error(this));
+  }
+}
+
+template<class Traits>
+typename basic_mpu<Traits>::fifo_view basic_mpu<Traits>::read_fifo(
+  std::span<hal::byte> p_buffer)
+{
+  check_fifo_overflow();
+  const auto frames =
+    std::min(fifo_sample_count(), p_buffer.size() / bytes_per_sample);
+  return read_fifo_frames(p_buffer, frames);
+}
+
+template<class Traits>
+std::span<raw_acceleration> basic_mpu<Traits>::read_fifo(
+  std::span<raw_acceleration> p_samples)
+{
+  // Samples are pulled over in chunks to bound stack usage
+  constexpr std::size_t samples_per_chunk = 16;
+  std::array<hal::byte, samples_per_chunk * bytes_per_sample> buffer;
+
+  check_fifo_overflow();
+  const auto available = std::min(fifo_sample_count(), p_samples.size());
+  auto output = p_samples.begin();
+
+  for (std::size_t start = 0; start < available; start += samples_per_chunk) {
+    const auto chunk = std::min(samples_per_chunk, available - start);
+    output = std::ranges::copy(read_fifo_frames(buffer, chunk), output).out;
+  }
+
+  return p_samples.first(available);
+}
+
+template<class Traits>
+raw_rotation basic_mpu<Traits>::read_raw_rotation()
 {
-  accelerometer::read_t acceleration;
   constexpr std::size_t bytes_per_axis = 2;
   constexpr std::size_t number_of_axis = 3;
 
-  std::array<hal::byte, bytes_per_axis * number_of_axis> xyz_acceleration;
+  std::array<hal::byte, bytes_per_axis * number_of_axis> xyz_rotation;
   hal::write_then_read(*m_i2c,
                        m_address,
-                       std::array{ xyz_register },
-                       xyz_acceleration,
+                       std::array{ Traits::gyroscope_register },
+                       xyz_rotation,
                        hal::never_timeout());
-  /**
-   * First X-axis Byte (MSB first)
-   * =========================================================================
-   * Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
-   *  XD15 | XD14  |  XD13 |  XD12 |  XD11 |  XD10 |  XD9  |  XD8
-   *
-   * Final X-axis Byte (LSB)
-   * =========================================================================
-   * Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
-   *   XD7 |   XD6 |   XD5 |   XD4 |   XD3 |   XD2 |   XD1 |   XD0
-   *
-   *
-   * We simply shift and OR the bytes together to get them into a signed int
-   * 16 value.
-   */
-  const auto x =
-    static_cast<std::int16_t>(xyz_acceleration[0] << 8 | xyz_acceleration[1]);
-  const auto y =
-    static_cast<std::int16_t>(xyz_acceleration[2] << 8 | xyz_acceleration[3]);
-  const auto z =
-    static_cast<std::int16_t>(xyz_acceleration[4] << 8 | xyz_acceleration[5]);
-
-  // Convert the 16 bit value into a floating point value m/S^2
-  constexpr auto max =
-    static_cast<float>(std::numeric_limits<std::int16_t>::max());
-  constexpr auto min =
-    static_cast<float>(std::numeric_limits<std::int16_t>::min());
-
-  const auto output_limits =
-    static_cast<float>(1 << (static_cast<int>(m_gscale) + 1));
-  auto input_range = std::make_pair(max, min);
-  auto output_range = std::make_pair(-output_limits, output_limits);
-
-  acceleration.x = hal::map(x, input_range, output_range);
-  acceleration.y = hal::map(y, input_range, output_range);
-  acceleration.z = hal::map(z, input_range, output_range);
-
-  return acceleration;
+
+  // Same big endian layout as the acceleration registers
+  const auto axes = decode(xyz_rotation, 0);
+  return { .x = axes.x, .y = axes.y, .z = axes.z, .scale = 0 };
+}
+
+template<class Traits>
+accelerometer::read_t basic_mpu<Traits>::driver_read()
+{
+  return to_read_t(read_raw());
 }
 
+template class basic_mpu<mpu6050_traits>;
+template class basic_mpu<mpu6500_traits>;
+template class basic_mpu<mpu9250_traits>;
 }  // namespace hal::mpu
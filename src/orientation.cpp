@@ -0,0 +1,168 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+
+#include <libhal-mpu/orientation.hpp>
+
+namespace hal::mpu {
+
+namespace {
+/// atan(2^-i) in fixed point degrees for each CORDIC iteration
+constexpr std::array<fixed_angle, 16> arc_tangents{
+  2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+  14668,   7334,    3667,   1833,   917,    458,    229,    115,
+};
+/// 1 / CORDIC gain for 16 iterations, with 15 fractional bits
+constexpr std::int64_t inverse_gain = 19898;
+/// Inputs are normalized so that their largest bit lands here, leaving room
+/// for the CORDIC gain (~1.65) and the diagonal (~1.41) without overflow.
+constexpr int normalized_top_bit = 28;
+
+struct polar_t
+{
+  fixed_angle angle;
+  std::int32_t magnitude;
+};
+
+/**
+ * @brief CORDIC in vectoring mode, rotates (x, y) onto the x axis
+ *
+ * @return polar_t - angle of the vector and its magnitude, in the same units
+ * as the inputs
+ */
+polar_t cordic_vectoring(std::int32_t p_y, std::int32_t p_x)
+{
+  fixed_angle angle = 0;
+
+  if (p_x == 0 && p_y == 0) {
+    return { .angle = 0, .magnitude = 0 };
+  }
+
+  // CORDIC only converges within ±99.7°, so rotate the left half plane by
+  // 180° first.
+  if (p_x < 0) {
+    angle = (p_y >= 0) ? 180 * fixed_degree : -180 * fixed_degree;
+    p_x = -p_x;
+    p_y = -p_y;
+  }
+
+  // Scale the inputs up so the shifts below keep as many bits as possible
+  const auto largest = static_cast<std::uint32_t>(p_x | std::abs(p_y));
+  const int shift = std::countl_zero(largest) - (31 - normalized_top_bit);
+  std::int32_t x = p_x << shift;
+  std::int32_t y = p_y << shift;
+
+  for (std::size_t i = 0; i < arc_tangents.size(); i++) {
+    const auto x_step = x >> i;
+    const auto y_step = y >> i;
+    if (y > 0) {
+      x += y_step;
+      y -= x_step;
+      angle += arc_tangents[i];
+    } else {
+      x -= y_step;
+      y += x_step;
+      angle -= arc_tangents[i];
+    }
+  }
+
+  const auto magnitude = (static_cast<std::int64_t>(x) * inverse_gain) >>
+                         (15 + static_cast<std::int64_t>(shift));
+
+  return { .angle = angle, .magnitude = static_cast<std::int32_t>(magnitude) };
+}
+
+/// Bring an angle back into -180° to 180°
+fixed_angle wrap(fixed_angle p_angle)
+{
+  constexpr fixed_angle half_turn = 180 * fixed_degree;
+  constexpr fixed_angle full_turn = 360 * fixed_degree;
+  if (p_angle > half_turn) {
+    return p_angle - full_turn;
+  }
+  if (p_angle < -half_turn) {
+    return p_angle + full_turn;
+  }
+  return p_angle;
+}
+}  // namespace
+
+fixed_angle fixed_atan2(std::int32_t p_y, std::int32_t p_x)
+{
+  return cordic_vectoring(p_y, p_x).angle;
+}
+
+tilt_t tilt(const raw_acceleration& p_sample)
+{
+  // roll = atan2(y, z) and pitch = atan2(-x, sqrt(y² + z²)). The magnitude
+  // needed for pitch comes for free out of the roll computation.
+  const auto roll = cordic_vectoring(p_sample.y, p_sample.z);
+  const auto pitch = cordic_vectoring(-p_sample.x, roll.magnitude);
+
+  return { .pitch = pitch.angle, .roll = roll.angle };
+}
+
+complementary_filter::complementary_filter(settings p_settings)
+  : m_settings(p_settings)
+{
+}
+
+tilt_t complementary_filter::update(const raw_acceleration& p_acceleration,
+                                    const raw_rotation& p_rotation,
+                                    std::uint32_t p_period_us)
+{
+  const auto measured = tilt(p_acceleration);
+
+  if (!m_initialized) {
+    m_initialized = true;
+    m_estimate = measured;
+    return m_estimate;
+  }
+
+  // Each count is full_scale_dps / 2^15 °/s, which is full_scale_dps * 2 in
+  // fixed point degrees per second. The step covers p_period_us microseconds,
+  // and dividing by one million is done as a multiply by 2^32 / 10^6 and a
+  // shift, since 64-bit division is slow on small cores.
+  constexpr std::int64_t reciprocal_of_million = 4295;
+  const std::int64_t step = static_cast<std::int64_t>(
+                              full_scale_dps(p_rotation.scale) * 2) *
+                            static_cast<std::int64_t>(p_period_us);
+  const std::int64_t accelerometer_weight =
+    fixed_degree - m_settings.gyroscope_weight;
+
+  auto fuse = [&](fixed_angle p_previous,
+                  std::int16_t p_rate,
+                  fixed_angle p_measured) -> fixed_angle {
+    const auto delta = (p_rate * step * reciprocal_of_million) >> 32;
+    const auto predicted = wrap(p_previous + static_cast<fixed_angle>(delta));
+    const auto error = wrap(p_measured - predicted);
+    const auto correction = (accelerometer_weight * error) >> 16;
+    return wrap(predicted + static_cast<fixed_angle>(correction));
+  };
+
+  m_estimate.roll = fuse(m_estimate.roll, p_rotation.x, measured.roll);
+  m_estimate.pitch = fuse(m_estimate.pitch, p_rotation.y, measured.pitch);
+
+  return m_estimate;
+}
+
+void complementary_filter::reset()
+{
+  m_initialized = false;
+}
+}  // namespace hal::mpu
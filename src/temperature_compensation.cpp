@@ -0,0 +1,157 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <libhal-mpu/temperature_compensation.hpp>
+#include <libhal/error.hpp>
+
+namespace hal::mpu {
+
+namespace {
+constexpr std::size_t max_terms = 3;
+using matrix_t = std::array<std::array<double, max_terms>, max_terms>;
+using vector_t = std::array<double, max_terms>;
+
+/**
+ * @brief Number of distinct temperatures in the samples, counting no higher
+ * than `p_limit`
+ */
+std::size_t distinct_temperatures(std::span<const thermal_sample> p_samples,
+                                  std::size_t p_limit)
+{
+  std::array<fixed_celsius, max_terms> seen{};
+  std::size_t count = 0;
+
+  for (const auto& sample : p_samples) {
+    const auto first = seen.begin();
+    const auto last = seen.begin() + static_cast<std::ptrdiff_t>(count);
+    if (std::find(first, last, sample.temperature) == last) {
+      seen[count++] = sample.temperature;
+      if (count == p_limit) {
+        break;
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+ * @brief Solve the first `p_terms` rows of A·x = b in place
+ *
+ * Gaussian elimination with partial pivoting. The system must not be
+ * singular.
+ */
+vector_t solve(matrix_t& p_a, vector_t& p_b, std::size_t p_terms)
+{
+  for (std::size_t column = 0; column < p_terms; column++) {
+    std::size_t pivot = column;
+    for (std::size_t row = column + 1; row < p_terms; row++) {
+      if (std::abs(p_a[row][column]) > std::abs(p_a[pivot][column])) {
+        pivot = row;
+      }
+    }
+    std::swap(p_a[column], p_a[pivot]);
+    std::swap(p_b[column], p_b[pivot]);
+
+    for (std::size_t row = column + 1; row < p_terms; row++) {
+      const auto factor = p_a[row][column] / p_a[column][column];
+      for (std::size_t i = column; i < p_terms; i++) {
+        p_a[row][i] -= factor * p_a[column][i];
+      }
+      p_b[row] -= factor * p_b[column];
+    }
+  }
+
+  vector_t x{};
+  for (std::size_t row = p_terms; row-- > 0;) {
+    auto sum = p_b[row];
+    for (std::size_t i = row + 1; i < p_terms; i++) {
+      sum -= p_a[row][i] * x[i];
+    }
+    x[row] = sum / p_a[row][row];
+  }
+  return x;
+}
+}  // namespace
+
+temperature_model fit_temperature_model(
+  std::span<const thermal_sample> p_samples,
+  const raw_acceleration& p_expected,
+  temperature_fit p_fit,
+  fixed_celsius p_reference)
+{
+  const std::size_t terms = p_fit == temperature_fit::quadratic ? 3 : 2;
+
+  if (distinct_temperatures(p_samples, terms) < terms) {
+    hal::safe_throw(hal::argument_out_of_domain(nullptr));
+  }
+
+  const std::array<std::int32_t, 3> expected{
+    normalize(p_expected.x, p_expected.gscale),
+    normalize(p_expected.y, p_expected.gscale),
+    normalize(p_expected.z, p_expected.gscale),
+  };
+
+  // Normal equations, shared by all axes apart from the right hand side
+  matrix_t normal{};
+  std::array<vector_t, 3> right_hand_sides{};
+
+  for (const auto& sample : p_samples) {
+    const auto delta = static_cast<double>(sample.temperature - p_reference) /
+                       fixed_celsius_degree;
+    const vector_t powers{ 1.0, delta, delta * delta };
+    const auto& acceleration = sample.acceleration;
+    const std::array<double, 3> bias{
+      static_cast<double>(normalize(acceleration.x, acceleration.gscale) -
+                          expected[0]),
+      static_cast<double>(normalize(acceleration.y, acceleration.gscale) -
+                          expected[1]),
+      static_cast<double>(normalize(acceleration.z, acceleration.gscale) -
+                          expected[2]),
+    };
+
+    for (std::size_t row = 0; row < terms; row++) {
+      for (std::size_t column = 0; column < terms; column++) {
+        normal[row][column] += powers[row] * powers[column];
+      }
+      for (std::size_t axis = 0; axis < bias.size(); axis++) {
+        right_hand_sides[axis][row] += bias[axis] * powers[row];
+      }
+    }
+  }
+
+  temperature_model model{};
+  model.reference = p_reference;
+
+  for (std::size_t axis = 0; axis < model.axes.size(); axis++) {
+    auto a = normal;
+    const auto coefficients = solve(a, right_hand_sides[axis], terms);
+    auto& result = model.axes[axis];
+    result.offset = static_cast<std::int32_t>(std::lround(coefficients[0]));
+    result.linear = static_cast<std::int32_t>(
+      std::lround(coefficients[1] * fixed_celsius_degree));
+    result.quadratic = static_cast<std::int32_t>(
+      std::lround(coefficients[2] * fixed_celsius_degree));
+  }
+
+  return model;
+}
+}  // namespace hal::mpu
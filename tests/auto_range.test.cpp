@@ -0,0 +1,94 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <boost/ut.hpp>
+#include <libhal-mpu/auto_range.hpp>
+#include <libhal/error.hpp>
+
+namespace hal::mpu {
+void auto_range_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  "auto_range::auto_range() rejects overlapping thresholds"_test = []() {
+    // Setup
+    auto_range::settings settings{ .upper_threshold = 20000,
+                                   .lower_threshold = 10000 };
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&settings]() { auto_range range(settings); }));
+  };
+
+  "auto_range::update() steps up on near saturation"_test = []() {
+    // Setup
+    auto_range range({}, 0);
+
+    // Exercise
+    auto first = range.update({ .x = 100, .y = -31000, .z = 0, .gscale = 0 });
+    auto second = range.update({ .x = 0, .y = 0, .z = -32768, .gscale = 1 });
+
+    // Verify
+    expect(eq(1, first));
+    expect(eq(2, second));
+  };
+
+  "auto_range::update() steps down only after hold samples"_test = []() {
+    // Setup
+    auto_range range({ .hold_samples = 4 }, 2);
+    const raw_acceleration quiet{
+      .x = 1000, .y = -2000, .z = 500, .gscale = 2
+    };
+
+    // Exercise
+    for (int i = 0; i < 3; i++) {
+      expect(eq(2, range.update(quiet)));
+    }
+    auto stepped = range.update(quiet);
+
+    // Verify
+    expect(eq(1, stepped));
+  };
+
+  "auto_range::update() resets hold on a loud sample"_test = []() {
+    // Setup
+    auto_range range({ .hold_samples = 2 }, 1);
+    const raw_acceleration quiet{ .x = 100, .gscale = 1 };
+    const raw_acceleration loud{ .x = 20000, .gscale = 1 };
+
+    // Exercise
+    range.update(quiet);
+    range.update(loud);
+    auto after_loud = range.update(quiet);
+    auto stepped = range.update(quiet);
+
+    // Verify
+    expect(eq(1, after_loud));
+    expect(eq(0, stepped));
+  };
+
+  "auto_range::update() respects limits and stale samples"_test = []() {
+    // Setup
+    auto_range range({ .hold_samples = 1, .maximum_gscale = 1 }, 1);
+
+    // Exercise
+    auto capped = range.update({ .x = 32767, .gscale = 1 });
+    auto stale = range.update({ .x = 0, .gscale = 0 });
+
+    // Verify
+    expect(eq(1, capped));
+    expect(eq(1, stale));
+  };
+};
+}  // namespace hal::mpu
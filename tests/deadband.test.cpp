@@ -0,0 +1,130 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <array>
+
+#include <boost/ut.hpp>
+#include <libhal-mpu/deadband.hpp>
+
+namespace hal::mpu {
+void deadband_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  "deadband::update() reports changes beyond the threshold"_test = []() {
+    // Setup
+    deadband filter({ .threshold = 100 });
+
+    // Exercise
+    auto first = filter.update({ .x = 0, .y = 0, .z = 16384, .gscale = 0 });
+    auto within =
+      filter.update({ .x = 100, .y = -100, .z = 16300, .gscale = 0 });
+    auto beyond = filter.update({ .x = 0, .y = -101, .z = 16384 });
+
+    // Verify
+    expect(first);
+    expect(not within);
+    expect(beyond);
+    expect(eq(-101, filter.last_reported().y));
+    expect(eq(1U, filter.suppressed()));
+  };
+
+  "deadband::update() compares against the last report"_test = []() {
+    // Setup
+    deadband filter({ .threshold = 100 });
+    expect(filter.update({ .x = 0, .y = 0, .z = 0, .gscale = 0 }));
+
+    // Exercise
+    // Each step is within the threshold of the one before it
+    auto step_1 = filter.update({ .x = 60, .y = 0, .z = 0, .gscale = 0 });
+    auto step_2 = filter.update({ .x = 120, .y = 0, .z = 0, .gscale = 0 });
+
+    // Verify
+    expect(not step_1);
+    expect(step_2);
+    expect(eq(120, filter.last_reported().x));
+  };
+
+  "deadband::update() reports once the interval elapses"_test = []() {
+    // Setup
+    deadband filter({ .threshold = 100, .max_interval = 3 });
+    const raw_acceleration idle{ .x = 5, .y = -5, .z = 16384, .gscale = 0 };
+    std::array<bool, 9> reports{};
+
+    // Exercise
+    for (auto& report : reports) {
+      report = filter.update(idle);
+    }
+
+    // Verify
+    expect(reports == std::array{
+                        true, false, false, false, true, false, false, false,
+                        true });
+    expect(eq(6U, filter.suppressed()));
+  };
+
+  "deadband::update() ignores a change of full scale"_test = []() {
+    // Setup
+    deadband filter({ .threshold = 10 });
+    expect(filter.update({ .x = 1000, .y = -2000, .z = 16384, .gscale = 0 }));
+
+    // Exercise
+    auto same = filter.update({ .x = 125, .y = -250, .z = 2048, .gscale = 3 });
+    // One count at ±16g is 8 counts at ±2g
+    auto moved = filter.update({ .x = 127, .y = -250, .z = 2048, .gscale = 3 });
+
+    // Verify
+    expect(not same);
+    expect(moved);
+  };
+
+  "deadband::filter() keeps reported samples in order"_test = []() {
+    // Setup
+    deadband filter({ .threshold = 50 });
+    std::array<raw_acceleration, 5> samples{ {
+      { .x = 0, .y = 0, .z = 0, .gscale = 0 },
+      { .x = 10, .y = 0, .z = 0, .gscale = 0 },
+      { .x = 0, .y = 500, .z = 0, .gscale = 0 },
+      { .x = 0, .y = 520, .z = 0, .gscale = 0 },
+      { .x = 0, .y = 520, .z = -80, .gscale = 0 },
+    } };
+
+    // Exercise
+    auto reported = filter.filter(samples);
+
+    // Verify
+    expect(eq(3U, reported.size()));
+    expect(eq(0, reported[0].y));
+    expect(eq(500, reported[1].y));
+    expect(eq(-80, reported[2].z));
+    expect(eq(2U, filter.suppressed()));
+  };
+
+  "deadband::reset() reports the next sample"_test = []() {
+    // Setup
+    deadband filter({ .threshold = 100 });
+    const raw_acceleration idle{ .x = 0, .y = 0, .z = 16384, .gscale = 0 };
+    expect(filter.update(idle));
+    expect(not filter.update(idle));
+
+    // Exercise
+    filter.reset();
+    auto after_reset = filter.update(idle);
+
+    // Verify
+    expect(after_reset);
+    expect(eq(0U, filter.suppressed()));
+  };
+};
+}  // namespace hal::mpu
@@ -11,20 +11,193 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <algorithm>
+
 #include <boost/ut.hpp>
 #include <libhal-mpu/lis3dhtr.hpp>
+#include <libhal/error.hpp>
+
+#include "mock_register_i2c.hpp"
 
 namespace hal::mpu {
+namespace {
+constexpr hal::byte who_am_i = 0x0F;
+constexpr hal::byte ctrl_reg1 = 0x20;
+constexpr hal::byte ctrl_reg2 = 0x21;
+constexpr hal::byte ctrl_reg3 = 0x22;
+constexpr hal::byte ctrl_reg4 = 0x23;
+constexpr hal::byte ctrl_reg5 = 0x24;
+constexpr hal::byte ctrl_reg6 = 0x25;
+constexpr hal::byte out_x_l = 0x28;
+constexpr hal::byte int1_cfg = 0x30;
+constexpr hal::byte int1_src = 0x31;
+constexpr hal::byte int1_ths = 0x32;
+constexpr hal::byte int1_duration = 0x33;
+constexpr hal::byte int2_cfg = 0x34;
+constexpr hal::byte int2_src = 0x35;
+constexpr hal::byte int2_ths = 0x36;
+constexpr hal::byte int2_duration = 0x37;
+constexpr hal::byte click_cfg = 0x38;
+constexpr hal::byte click_src = 0x39;
+constexpr hal::byte click_ths = 0x3A;
+constexpr hal::byte time_limit = 0x3B;
+constexpr hal::byte time_latency = 0x3C;
+constexpr hal::byte time_window = 0x3D;
+
+mock_register_i2c make_device()
+{
+  mock_register_i2c device;
+  device.registers[who_am_i] = 0x33;
+  // power on default, all axes enabled
+  device.registers[ctrl_reg1] = 0x07;
+  return device;
+}
+}  // namespace
+
 void lis3dhtr_test()
 {
   using namespace boost::ut;
   using namespace std::literals;
 
-  "lis3dhtr::create()"_test = []() {
+  "lis3dhtr::lis3dhtr()"_test = []() {
+    // Setup
+    auto device = make_device();
+    auto wrong_id = make_device();
+    wrong_id.registers[who_am_i] = 0x44;
+
+    // Exercise
+    lis3dhtr lis(device);
+
+    // Verify
+    // 400Hz with the axes left enabled
+    expect(eq(hal::byte{ 0x77 }, device.registers[ctrl_reg1]));
+    expect(throws<hal::no_such_device>([&]() { lis3dhtr rejected(wrong_id); }));
+  };
+
+  "lis2dh12::read_raw()"_test = []() {
+    // Setup
+    auto device = make_device();
+    lis2dh12 lis(device);
+    lis.configure_full_scale(lis2dh12::max_acceleration::g8);
+    // X = 0x1234, Y = -2, Z = 16384, low byte first
+    const std::array<hal::byte, 6> output{ 0x34, 0x12, 0xFE, 0xFF, 0x00, 0x40 };
+    std::copy(output.begin(), output.end(), device.registers.begin() + out_x_l);
+
+    // Exercise
+    auto sample = lis.read_raw();
+
+    // Verify
+    expect(eq(0x1234, sample.x));
+    expect(eq(-2, sample.y));
+    expect(eq(16384, sample.z));
+    expect(eq(hal::byte{ 2 }, sample.gscale));
+    expect(eq(hal::byte{ 0b10'0000 }, device.registers[ctrl_reg4]));
+  };
+
+  "lis3dhtr::read_raw() matches the virtual read path"_test = []() {
+    // Setup
+    auto device = make_device();
+    lis3dhtr lis(device);
+    lis.configure_full_scale(lis3dhtr::max_acceleration::g4);
+    // X = -16384, Y = 8192, Z = 0x7FF0, low byte first
+    const std::array<hal::byte, 6> output{ 0x00, 0xC0, 0x00, 0x20, 0xF0, 0x7F };
+    std::copy(output.begin(), output.end(), device.registers.begin() + out_x_l);
+    hal::accelerometer& accelerometer = lis;
+    const auto transactions = device.transactions;
+
+    // Exercise
+    auto sample = lis.read_raw();
+    const auto raw_transactions = device.transactions - transactions;
+    auto converted = accelerometer.read();
+
+    // Verify
+    // The whole sample comes over in one auto incremented read
+    expect(eq(1U, raw_transactions));
+    expect(eq(-16384, sample.x));
+    expect(eq(8192, sample.y));
+    expect(eq(0x7FF0, sample.z));
+    expect(eq(hal::byte{ 1 }, sample.gscale));
+    const auto expected = to_read_t(sample);
+    expect(eq(expected.x, converted.x));
+    expect(eq(expected.y, converted.y));
+    expect(eq(expected.z, converted.z));
+  };
+
+  "lis3dhtr::configure_events() and read_events()"_test = []() {
     // Setup
+    auto device = make_device();
+    lis3dhtr lis(device);
+    lis3dhtr::event_settings settings;
+    settings.motion = { .threshold = 0.32f, .duration = 2 };
+    lis3dhtr::event_settings too_large;
+    too_large.motion = { .threshold = 4.0f, .duration = 0 };
 
     // Exercise
+    lis.configure_events(settings);
+    device.registers[int1_src] = 0b0110'0000;
+    device.registers[click_src] = 0;
+    auto events = lis.read_events();
+
+    // Verify
+    // 16mg per LSB at 2g
+    expect(eq(hal::byte{ 20 }, device.registers[int1_ths]));
+    expect(eq(hal::byte{ 2 }, device.registers[int1_duration]));
+    expect(eq(hal::byte{ 0b0010'1010 }, device.registers[int1_cfg]));
+    expect(eq(hal::byte{ 0b0100'0000 }, device.registers[ctrl_reg3]));
+    expect(events.motion);
+    expect(events.motion_z);
+    expect(not events.motion_x);
+    expect(not events.free_fall);
+    expect(not events.click);
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { lis.configure_events(too_large); }));
+  };
+
+  "lis3dhtr::configure_events() free fall and double click"_test = []() {
+    // Setup
+    auto device = make_device();
+    lis3dhtr lis(device);
+    lis.configure_full_scale(lis3dhtr::max_acceleration::g4);
+    lis3dhtr::event_settings settings;
+    settings.free_fall = { .threshold = 0.32f, .duration = 3 };
+    settings.click = lis3dhtr::click_settings{};
+    settings.click->threshold = 0.62f;
+    settings.click->double_click = true;
+    settings.active_low = true;
+    lis3dhtr::event_settings too_long;
+    too_long.free_fall = { .threshold = 0.32f, .duration = 128 };
+
+    // Exercise
+    lis.configure_events(settings);
+    device.registers[int1_src] = 0;
+    device.registers[int2_src] = 0b0101'0101;
+    device.registers[click_src] = 0b0010'0000;
+    auto events = lis.read_events();
+
     // Verify
+    // 32mg per LSB at 4g
+    expect(eq(hal::byte{ 10 }, device.registers[int2_ths]));
+    expect(eq(hal::byte{ 3 }, device.registers[int2_duration]));
+    expect(eq(hal::byte{ 0b1001'0101 }, device.registers[int2_cfg]));
+    expect(eq(hal::byte{ 0 }, device.registers[int1_cfg]));
+    // Latched, 19 steps of 32mg
+    expect(eq(hal::byte{ 0x80 | 19 }, device.registers[click_ths]));
+    expect(eq(hal::byte{ 10 }, device.registers[time_limit]));
+    expect(eq(hal::byte{ 20 }, device.registers[time_latency]));
+    expect(eq(hal::byte{ 50 }, device.registers[time_window]));
+    expect(eq(hal::byte{ 0b0010'1010 }, device.registers[click_cfg]));
+    // High pass filter on the click engine only
+    expect(eq(hal::byte{ 0b0000'0100 }, device.registers[ctrl_reg2]));
+    // Click and interrupt generator 2 routed to INT1
+    expect(eq(hal::byte{ 0b1010'0000 }, device.registers[ctrl_reg3]));
+    expect(eq(hal::byte{ 0b0000'1010 }, device.registers[ctrl_reg5]));
+    expect(eq(hal::byte{ 0b0000'0010 }, device.registers[ctrl_reg6]));
+    expect(events.free_fall);
+    expect(events.double_click);
+    expect(not events.click);
+    expect(not events.motion);
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { lis.configure_events(too_long); }));
   };
 };
-}  // namespace hal::mpu
\ No newline at end of file
+}  // namespace hal::mpu
@@ -14,9 +14,25 @@
 
 namespace hal::mpu {
 extern void mpu6050_test();
+extern void lis3dhtr_test();
+extern void auto_range_test();
+extern void orientation_test();
+extern void vibration_spectrum_test();
+extern void window_statistics_test();
+extern void temperature_compensation_test();
+extern void deadband_test();
+extern void sensor_group_test();
 }  // namespace hal::mpu
 
 int main()
 {
   hal::mpu::mpu6050_test();
+  hal::mpu::lis3dhtr_test();
+  hal::mpu::auto_range_test();
+  hal::mpu::orientation_test();
+  hal::mpu::vibration_spectrum_test();
+  hal::mpu::window_statistics_test();
+  hal::mpu::temperature_compensation_test();
+  hal::mpu::deadband_test();
+  hal::mpu::sensor_group_test();
 }
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <libhal/error.hpp>
+#include <libhal/i2c.hpp>
+
+namespace hal::mpu {
+/**
+ * @brief I2C mock that behaves like a device with a flat register file
+ *
+ * The first byte written selects a register, any further bytes are written
+ * starting at that register and reads continue from it, incrementing after
+ * each byte. The most significant bit of the register address is ignored so
+ * that LIS3DH style auto increment addresses land on the right register.
+ *
+ * Reads that start at `stream_register` instead pop bytes off of `stream`,
+ * like reading a FIFO data register.
+ */
+class mock_register_i2c : public hal::i2c
+{
+public:
+  std::array<hal::byte, 128> registers{};
+  /// Number of transactions performed on the bus
+  std::size_t transactions = 0;
+  /// Number of transactions that wrote to at least one register
+  std::size_t register_writes = 0;
+  /// Register that reads from `stream`, none by default
+  std::size_t stream_register = 0xFF;
+  /// Bytes returned by reads of `stream_register`, oldest first
+  std::vector<hal::byte> stream;
+  /// Number of bytes of `stream` that have been read
+  std::size_t stream_position = 0;
+  /// When false, transactions fail as if no device acknowledged the address
+  bool acknowledge = true;
+
+private:
+  void driver_configure(const settings&) override
+  {
+  }
+
+  void driver_transaction(hal::byte p_address,
+                          std::span<const hal::byte> p_data_out,
+                          std::span<hal::byte> p_data_in,
+                          hal::function_ref<hal::timeout_function>) override
+  {
+    transactions++;
+    if (!acknowledge) {
+      hal::safe_throw(hal::no_such_device(p_address, this));
+    }
+    if (p_data_out.empty()) {
+      return;
+    }
+
+    std::size_t address = p_data_out[0] & 0x7F;
+    if (p_data_out.size() > 1) {
+      register_writes++;
+    }
+    for (const auto byte : p_data_out.subspan(1)) {
+      registers[address++ % registers.size()] = byte;
+    }
+    if (address == stream_register) {
+      for (auto& byte : p_data_in) {
+        byte = stream_position < stream.size() ? stream[stream_position++] : 0;
+      }
+      return;
+    }
+    for (auto& byte : p_data_in) {
+      byte = registers[address++ % registers.size()];
+    }
+  }
+};
+}  // namespace hal::mpu
@@ -11,10 +11,59 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <ranges>
+
 #include <boost/ut.hpp>
 #include <libhal-mpu/mpu6050.hpp>
+#include <libhal/error.hpp>
+
+#include "mock_register_i2c.hpp"
 
 namespace hal::mpu {
+namespace {
+constexpr hal::byte who_am_i = 0x75;
+constexpr hal::byte accel_config = 0x1C;
+constexpr hal::byte accel_xout_h = 0x3B;
+constexpr hal::byte motion_threshold = 0x1F;
+constexpr hal::byte motion_duration = 0x20;
+constexpr hal::byte int_pin_config = 0x37;
+constexpr hal::byte int_enable = 0x38;
+constexpr hal::byte int_status = 0x3A;
+constexpr hal::byte data_ready = 1 << 0;
+constexpr hal::byte motion_detect_status = 0x61;
+constexpr hal::byte sample_rate_divider = 0x19;
+constexpr hal::byte config = 0x1A;
+constexpr hal::byte fifo_enable = 0x23;
+constexpr hal::byte user_control = 0x6A;
+constexpr hal::byte fifo_count_high = 0x72;
+constexpr hal::byte fifo_count_low = 0x73;
+constexpr hal::byte fifo_data = 0x74;
+constexpr hal::byte accel_intelligence_control = 0x69;
+constexpr hal::byte power_management_1 = 0x6B;
+constexpr hal::byte power_management_2 = 0x6C;
+constexpr hal::byte low_power_accel_rate = 0x1E;
+
+mock_register_i2c make_device()
+{
+  mock_register_i2c device;
+  device.registers[who_am_i] = 0x68;
+  return device;
+}
+
+void set_acceleration(mock_register_i2c& p_device,
+                      std::int16_t p_x,
+                      std::int16_t p_y,
+                      std::int16_t p_z)
+{
+  std::size_t index = accel_xout_h;
+  for (const auto axis : { p_x, p_y, p_z }) {
+    const auto value = static_cast<std::uint16_t>(axis);
+    p_device.registers[index++] = static_cast<hal::byte>(value >> 8);
+    p_device.registers[index++] = static_cast<hal::byte>(value & 0xFF);
+  }
+}
+}  // namespace
+
 void mpu6050_test()
 {
   using namespace boost::ut;
@@ -25,5 +74,542 @@ void mpu6050_test()
     // Exercise
     // Verify
   };
+
+  "mpu6050::read_raw()"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    set_acceleration(device, 16384, -8192, 1);
+
+    // Exercise
+    auto sample = mpu.read_raw();
+
+    // Verify
+    expect(eq(16384, sample.x));
+    expect(eq(-8192, sample.y));
+    expect(eq(1, sample.z));
+    expect(eq(0, sample.gscale));
+  };
+
+  "mpu6050::decode()"_test = []() {
+    // Setup
+    constexpr std::array<hal::byte, mpu6050::bytes_per_sample> data{
+      0x80, 0x00, 0x7F, 0xFF, 0xFF, 0xFE
+    };
+
+    // Exercise
+    constexpr auto sample = mpu6050::decode(data, 2);
+
+    // Verify
+    static_assert(sample.x == -32768);
+    static_assert(sample.y == 32767);
+    static_assert(sample.z == -2);
+    static_assert(sample.gscale == 2);
+  };
+
+  "mpu6050::enable_auto_range() steps up on saturation"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.enable_auto_range();
+    set_acceleration(device, 32767, 0, 0);
+    const auto transactions_before = device.transactions;
+
+    // Exercise
+    auto saturated = mpu.read_raw();
+    const auto settling_enable = device.registers[int_enable];
+    set_acceleration(device, 16384, 0, 0);
+    device.registers[int_status] = data_ready;
+    auto next = mpu.read_raw();
+
+    // Verify
+    expect(eq(0, saturated.gscale));
+    expect(eq(1, next.gscale));
+    expect(eq(hal::byte{ 1 << 3 }, device.registers[accel_config]));
+    // DATA_RDY is enabled until the sample at the new scale arrives
+    expect(eq(data_ready, settling_enable));
+    expect(eq(hal::byte{ 0 }, device.registers[int_enable]));
+    // two reads, the write that changed the scale, the read that cleared
+    // DATA_RDY, and enabling then restoring the DATA_RDY interrupt
+    expect(eq(transactions_before + 6, device.transactions));
+  };
+
+  "mpu6050::enable_auto_range() waits for a sample at the new scale"_test =
+    []() {
+      // Setup
+      auto device = make_device();
+      mpu6050 mpu(device);
+      mpu.enable_auto_range();
+      device.registers[int_status] = data_ready;
+      set_acceleration(device, -31000, 0, 0);
+
+      // Exercise
+      auto saturated = mpu.read_raw();
+      // The device has not captured a sample since ACCEL_CONFIG changed, so
+      // the registers still hold the one from the ±2g scale.
+      device.registers[int_status] = 0;
+      const auto transactions = device.transactions;
+      auto stale = mpu.read_raw();
+      auto still_stale = mpu.read_raw();
+      set_acceleration(device, -15500, 0, 0);
+      device.registers[int_status] = data_ready;
+      auto fresh = mpu.read_raw();
+
+      // Verify
+      expect(eq(0, saturated.gscale));
+      // Tagged with the scale they were captured at, and one transaction each
+      expect(eq(0, stale.gscale));
+      expect(eq(-31000, stale.x));
+      expect(eq(0, still_stale.gscale));
+      // plus restoring INT_ENABLE once the fresh sample arrived
+      expect(eq(transactions + 4, device.transactions));
+      expect(eq(1, fresh.gscale));
+      expect(eq(-15500, fresh.x));
+      // Stale samples did not step the range up a second time
+      expect(eq(hal::byte{ 1 << 3 }, device.registers[accel_config]));
+    };
+
+  "mpu6050::read_events() sees the sample at the new scale"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.enable_auto_range();
+    set_acceleration(device, -31000, 0, 0);
+    mpu.read_raw();
+    set_acceleration(device, -15500, 0, 0);
+    device.registers[int_status] = data_ready;
+
+    // Exercise
+    auto events = mpu.read_events();
+    // Reading INT_STATUS cleared DATA_RDY
+    device.registers[int_status] = 0;
+    const auto transactions = device.transactions;
+    auto sample = mpu.read_raw();
+
+    // Verify
+    expect(events.data_ready);
+    // The DATA_RDY taken by read_events() still ended the scale change
+    expect(eq(1, sample.gscale));
+    expect(eq(-15500, sample.x));
+    expect(eq(transactions + 1, device.transactions));
+  };
+
+  "mpu6050::configure_events() while the scale settles"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.enable_auto_range();
+    set_acceleration(device, -31000, 0, 0);
+    mpu.read_raw();
+    mpu6050::event_settings settings;
+    settings.motion = mpu6050::motion_settings{};
+
+    // Exercise
+    mpu.configure_events(settings);
+    const auto settling_enable = device.registers[int_enable];
+    set_acceleration(device, -15500, 0, 0);
+    device.registers[int_status] = data_ready;
+    auto sample = mpu.read_raw();
+
+    // Verify
+    // DATA_RDY stays enabled next to motion until the new scale arrives
+    expect(eq(hal::byte{ 0b0100'0001 }, settling_enable));
+    expect(eq(1, sample.gscale));
+    expect(eq(hal::byte{ 0b0100'0000 }, device.registers[int_enable]));
+  };
+
+  "mpu6050::enable_auto_range() steps down with hysteresis"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    device.registers[int_status] = data_ready;
+    mpu.configure_full_scale(mpu6050::max_acceleration::g16);
+    mpu.enable_auto_range({ .hold_samples = 3 });
+    set_acceleration(device, 100, 100, 2048);
+
+    // Exercise
+    hal::byte last_gscale = 0;
+    for (int i = 0; i < 3; i++) {
+      last_gscale = mpu.read_raw().gscale;
+    }
+    auto stepped = mpu.read_raw();
+
+    // Verify
+    expect(eq(3, last_gscale));
+    expect(eq(2, stepped.gscale));
+    expect(eq(hal::byte{ 2 << 3 }, device.registers[accel_config]));
+  };
+
+  "mpu6050::configure_events() enables motion detection"_test = []() {
+    // Setup
+    using namespace std::chrono_literals;
+    auto device = make_device();
+    mpu6050 mpu(device);
+
+    mpu6050::event_settings settings;
+    settings.motion = { .threshold = 0.08f, .duration = 5ms };
+    settings.latch = true;
+    settings.active_low = true;
+
+    // Exercise
+    mpu.configure_events(settings);
+
+    // Verify
+    expect(eq(hal::byte{ 40 }, device.registers[motion_threshold]));
+    expect(eq(hal::byte{ 5 }, device.registers[motion_duration]));
+    expect(eq(hal::byte{ 0b0100'0000 }, device.registers[int_enable]));
+    expect(eq(hal::byte{ 0b1010'0000 }, device.registers[int_pin_config]));
+    // high pass filter at 5Hz
+    expect(eq(hal::byte{ 0b001 }, device.registers[accel_config]));
+  };
+
+  "mpu6050::configure_events() rejects unsupported settings"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu6050::event_settings too_large;
+    too_large.motion = { .threshold = 1.0f };
+    mpu6050::event_settings conflicting;
+    conflicting.motion = mpu6050::motion_settings{};
+    conflicting.free_fall = mpu6050::free_fall_settings{};
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { mpu.configure_events(too_large); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { mpu.configure_events(conflicting); }));
+  };
+
+  "mpu6050::read_events()"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    device.registers[int_status] = 0b0101'0000;
+    device.registers[motion_detect_status] = 0b0000'1000;
+
+    // Exercise
+    auto events = mpu.read_events();
+
+    // Verify
+    expect(events.motion);
+    expect(events.fifo_overflow);
+    expect(not events.free_fall);
+    expect(not events.data_ready);
+    expect(not events.motion_x);
+    expect(not events.motion_y);
+    expect(events.motion_z);
+  };
+
+  "mpu6050::configure_sample_rate()"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+
+    // Exercise
+    auto rate = mpu.configure_sample_rate(100.0f);
+    // 1kHz / 1e-6Hz does not fit in a 32-bit long
+    auto slowest = mpu.configure_sample_rate(1e-6f);
+    const auto slowest_divider = device.registers[sample_rate_divider];
+    auto fastest = mpu.configure_sample_rate(5000.0f);
+
+    // Verify
+    expect(eq(100.0f, rate));
+    expect(eq(1000.0f / 256.0f, slowest));
+    expect(eq(hal::byte{ 255 }, slowest_divider));
+    expect(eq(1000.0f, fastest));
+    expect(eq(hal::byte{ 0 }, device.registers[sample_rate_divider]));
+    expect(eq(hal::byte{ 1 }, device.registers[config]));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { mpu.configure_sample_rate(0.0f); }));
+  };
+
+  "mpu6050::enable_fifo() and read_fifo()"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    device.stream_register = fifo_data;
+    constexpr std::size_t sample_count = 20;
+    for (std::size_t i = 0; i < sample_count; i++) {
+      const auto value = static_cast<std::uint16_t>(i * 100);
+      const auto negative = static_cast<std::uint16_t>(-value);
+      for (const auto axis : { value, negative, std::uint16_t{ 16384 } }) {
+        device.stream.push_back(static_cast<hal::byte>(axis >> 8));
+        device.stream.push_back(static_cast<hal::byte>(axis & 0xFF));
+      }
+    }
+    // a partially written sample at the end is not counted
+    constexpr std::size_t fifo_bytes = sample_count * 6 + 4;
+    device.registers[fifo_count_high] = fifo_bytes >> 8;
+    device.registers[fifo_count_low] = fifo_bytes & 0xFF;
+    std::array<raw_acceleration, 32> samples{};
+
+    // Exercise
+    mpu.enable_fifo();
+    auto count = mpu.fifo_sample_count();
+    auto filled = mpu.read_fifo(samples);
+
+    // Verify
+    expect(eq(hal::byte{ 1 << 3 }, device.registers[fifo_enable]));
+    expect(eq(hal::byte{ 1 << 6 }, device.registers[user_control] & (1 << 6)));
+    expect(eq(sample_count, count));
+    expect(eq(sample_count, filled.size()));
+    expect(eq(sample_count * 6, device.stream_position));
+    for (std::size_t i = 0; i < filled.size(); i++) {
+      expect(eq(static_cast<int>(i * 100), filled[i].x));
+      expect(eq(-static_cast<int>(i * 100), filled[i].y));
+      expect(eq(16384, filled[i].z));
+    }
+  };
+
+  "mpu6050::read_fifo() resets the FIFO after an overflow"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.enable_fifo();
+    device.stream_register = fifo_data;
+    // 1024 bytes hold 170 samples and the first 4 bytes of another, so the
+    // overwritten FIFO no longer starts on a sample.
+    device.stream.assign(1024, 0xA5);
+    device.registers[fifo_count_high] = 1024 >> 8;
+    device.registers[fifo_count_low] = 1024 & 0xFF;
+    // FIFO_OFLOW_INT and MOT_INT
+    device.registers[int_status] = 0b0101'0000;
+    device.registers[user_control] = 0;
+    std::array<raw_acceleration, mpu6050::fifo_capacity> samples{};
+
+    // Exercise
+    const bool threw = throws<hal::io_error>([&]() { mpu.read_fifo(samples); });
+    const auto user_control_after = device.registers[user_control];
+    device.registers[int_status] = 0;
+    auto events = mpu.read_events();
+
+    // Verify
+    expect(threw);
+    // Nothing was drained, the FIFO was reset and left enabled
+    expect(eq(0U, device.stream_position));
+    expect(eq(hal::byte{ 0b0100'0100 }, user_control_after));
+    // The overflow was reported by the exception, other events are kept
+    expect(not events.fifo_overflow);
+    expect(events.motion);
+  };
+
+  "mpu6050::read_fifo() after read_events() saw the overflow"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.enable_fifo();
+    device.stream_register = fifo_data;
+    device.stream.assign(1024, 0xA5);
+    device.registers[fifo_count_high] = 1024 >> 8;
+    device.registers[fifo_count_low] = 1024 & 0xFF;
+    // FIFO_OFLOW_INT
+    device.registers[int_status] = 0b0001'0000;
+    std::array<raw_acceleration, mpu6050::fifo_capacity> samples{};
+
+    // Exercise
+    auto events = mpu.read_events();
+    // Reading INT_STATUS cleared it
+    device.registers[int_status] = 0;
+    const bool threw = throws<hal::io_error>([&]() { mpu.read_fifo(samples); });
+    const auto stream_position = device.stream_position;
+    device.stream.assign(12, 0x00);
+    device.stream_position = 0;
+    device.registers[fifo_count_high] = 0;
+    device.registers[fifo_count_low] = 12;
+    auto resumed = mpu.read_fifo(samples);
+
+    // Verify
+    expect(events.fifo_overflow);
+    expect(threw);
+    expect(eq(0U, stream_position));
+    // The overflow was handled once, frames buffered after the reset drain
+    expect(eq(2U, resumed.size()));
+  };
+
+  "mpu6050::configure_full_scale() empties the FIFO"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.enable_fifo();
+    device.stream_register = fifo_data;
+    device.registers[user_control] = 0;
+    // FIFO_OFLOW_INT from frames captured at the old scale
+    device.registers[int_status] = 0b0001'0000;
+    std::array<raw_acceleration, 4> samples{};
+
+    // Exercise
+    mpu.configure_full_scale(mpu6050::max_acceleration::g4);
+    const auto user_control_after = device.registers[user_control];
+    device.registers[int_status] = 0;
+    device.stream = { 0x00, 0x01, 0x00, 0x02, 0x00, 0x03 };
+    device.registers[fifo_count_low] = 6;
+    auto filled = mpu.read_fifo(samples);
+
+    // Verify
+    // Reset and left enabled, the discarded frames no longer count as an
+    // overflow
+    expect(eq(hal::byte{ 0b0100'0100 }, user_control_after));
+    expect(eq(1U, filled.size()));
+    expect(eq(1, filled[0].x));
+    expect(eq(hal::byte{ 1 }, filled[0].gscale));
+  };
+
+  "mpu6050::read_fifo() into a byte buffer"_test = []() {
+    // Setup
+    static_assert(std::ranges::forward_range<mpu6050::fifo_view>);
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu.configure_full_scale(mpu6050::max_acceleration::g8);
+    device.stream_register = fifo_data;
+    device.stream = { 0x00, 0x01, 0xFF, 0xFF, 0x40, 0x00,
+                      0x00, 0x02, 0xFF, 0xFE, 0x20, 0x00,
+                      0x00, 0x03, 0xFF, 0xFD, 0x10, 0x00,
+                      0x00, 0x04, 0xFF, 0xFC, 0x08, 0x00 };
+    device.registers[fifo_count_low] = 24;
+    // Room for three frames and part of a fourth
+    std::array<hal::byte, 20> buffer{};
+    const auto transactions = device.transactions;
+
+    // Exercise
+    auto frames = mpu.read_fifo(buffer);
+
+    // Verify
+    // Checking for an overflow, counting the FIFO, then one burst read of
+    // whole frames
+    expect(eq(transactions + 3, device.transactions));
+    expect(eq(18U, device.stream_position));
+    expect(eq(3U, frames.size()));
+    expect(frames.bytes().data() == buffer.data());
+    expect(eq(18U, frames.bytes().size()));
+    expect(eq(0x1000, frames[2].z));
+    std::int16_t expected_x = 1;
+    for (const auto sample : frames) {
+      expect(eq(expected_x, sample.x));
+      expect(eq(-expected_x, sample.y));
+      expect(eq(hal::byte{ 2 }, sample.gscale));
+      expected_x++;
+    }
+    expect(eq(4, expected_x));
+  };
+
+  "basic_mpu::probe() tells the variants apart"_test = []() {
+    // Setup
+    auto device = make_device();
+    device.registers[who_am_i] = 0x70;
+    mock_register_i2c absent;
+    absent.acknowledge = false;
+
+    // Exercise + Verify
+    expect(mpu6500::probe(device));
+    expect(not mpu6050::probe(device));
+    expect(not mpu9250::probe(device));
+    expect(not mpu6500::probe(absent));
+    expect(throws<hal::no_such_device>([&]() { mpu6050 rejected(device); }));
+    // Constructing the matching variant succeeds
+    mpu6500 accepted(device);
+  };
+
+  "mpu6500::configure_events() uses wake on motion"_test = []() {
+    // Setup
+    auto device = make_device();
+    device.registers[who_am_i] = 0x70;
+    mpu6500 mpu(device);
+    mpu6500::event_settings settings;
+    settings.motion = { .threshold = 0.08f, .duration = 5ms };
+    mpu6500::event_settings free_fall;
+    free_fall.free_fall = mpu6500::free_fall_settings{};
+
+    // Exercise
+    mpu.configure_events(settings);
+
+    // Verify
+    // 4mg per LSB and no duration register
+    expect(eq(hal::byte{ 20 }, device.registers[motion_threshold]));
+    expect(eq(hal::byte{ 0 }, device.registers[motion_duration]));
+    expect(eq(hal::byte{ 0b1100'0000 },
+              device.registers[accel_intelligence_control]));
+    expect(eq(hal::byte{ 0b0100'0000 }, device.registers[int_enable]));
+    // ACCEL_CONFIG has no high pass filter on this part
+    expect(eq(hal::byte{ 0 }, device.registers[accel_config]));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { mpu.configure_events(free_fall); }));
+  };
+
+  "mpu6050::accelerometer_profile()"_test = []() {
+    // Setup
+    using wake_rate = mpu6050::wake_rate;
+
+    // Exercise
+    auto slowest = mpu6050::accelerometer_profile(1.0f);
+    auto exact = mpu6050::accelerometer_profile(20.0f);
+    auto between = mpu6050::accelerometer_profile(6.0f);
+    auto continuous = mpu6050::accelerometer_profile(100.0f);
+    auto between_6500 = mpu6500::accelerometer_profile(6.0f);
+
+    // Verify
+    expect(slowest.cycle == wake_rate::hz1_25);
+    expect(exact.cycle == wake_rate::hz20);
+    expect(between.cycle == wake_rate::hz20);
+    expect(not continuous.cycle.has_value());
+    expect(not continuous.gyroscope);
+    // 7.81Hz is enough on the MPU6500
+    expect(between_6500.cycle == mpu6500::wake_rate::hz5);
+  };
+
+  "mpu6050::configure_power() enters cycle mode"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    device.registers[power_management_1] = 0b0100'0001;
+    mpu.power_on();
+
+    // Exercise
+    auto latency = mpu.configure_power(mpu6050::accelerometer_profile(5.0f));
+
+    // Verify
+    // 5Hz wake up with the gyroscope in standby
+    expect(eq(hal::byte{ 0b0100'0111 }, device.registers[power_management_2]));
+    // CYCLE and TEMP_DIS set, clock source untouched
+    expect(eq(hal::byte{ 0b0010'1001 }, device.registers[power_management_1]));
+    expect(latency == 220ms);
+  };
+
+  "mpu6050::configure_power() puts axes into standby"_test = []() {
+    // Setup
+    auto device = make_device();
+    mpu6050 mpu(device);
+    mpu6050::power_profile profile;
+    profile.accelerometer_x = false;
+    profile.accelerometer_y = false;
+    mpu6050::power_profile cycling_gyroscope;
+    cycling_gyroscope.cycle = mpu6050::wake_rate::hz40;
+
+    // Exercise
+    auto latency = mpu.configure_power(profile);
+
+    // Verify
+    expect(eq(hal::byte{ 0b0011'0000 }, device.registers[power_management_2]));
+    expect(eq(hal::byte{ 0 }, device.registers[power_management_1]));
+    expect(latency == 30ms);
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { mpu.configure_power(cycling_gyroscope); }));
+  };
+
+  "mpu6500::configure_power() sets the low power rate"_test = []() {
+    // Setup
+    auto device = make_device();
+    device.registers[who_am_i] = 0x70;
+    mpu6500 mpu(device);
+
+    // Exercise
+    auto latency = mpu.configure_power(mpu6500::accelerometer_profile(40.0f));
+
+    // Verify
+    // 62.5Hz, PWR_MGMT_2 has no rate bits on this part
+    expect(eq(hal::byte{ 8 }, device.registers[low_power_accel_rate]));
+    expect(eq(hal::byte{ 0b0000'0111 }, device.registers[power_management_2]));
+    expect(eq(hal::byte{ 0b0010'1000 }, device.registers[power_management_1]));
+    expect(latency == 36ms);
+  };
 };
-}  // namespace hal::mpu
\ No newline at end of file
+}  // namespace hal::mpu
@@ -0,0 +1,146 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <cmath>
+#include <numbers>
+
+#include <boost/ut.hpp>
+#include <libhal-mpu/orientation.hpp>
+
+namespace hal::mpu {
+namespace {
+double to_degrees(fixed_angle p_angle)
+{
+  return static_cast<double>(p_angle) / fixed_degree;
+}
+
+double reference_atan2(double p_y, double p_x)
+{
+  return std::atan2(p_y, p_x) * 180.0 / std::numbers::pi;
+}
+
+/// Smallest difference between two angles in degrees, across the ±180° seam
+double angle_error(double p_actual, double p_expected)
+{
+  auto error = std::fmod(std::abs(p_actual - p_expected), 360.0);
+  return std::min(error, 360.0 - error);
+}
+
+std::int16_t to_counts(double p_g)
+{
+  // 1g at the ±2g full scale
+  return static_cast<std::int16_t>(std::lround(p_g * 16384.0));
+}
+}  // namespace
+
+void orientation_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  "fixed_atan2() matches double precision reference"_test = []() {
+    // Setup
+    constexpr double tolerance = 0.01;
+    double worst_error = 0.0;
+
+    // Exercise
+    for (int degrees = -179; degrees <= 180; degrees++) {
+      for (const double radius : { 3.0, 100.0, 16384.0, 32767.0 }) {
+        const double radians = degrees * std::numbers::pi / 180.0;
+        const auto x = static_cast<std::int32_t>(radius * std::cos(radians));
+        const auto y = static_cast<std::int32_t>(radius * std::sin(radians));
+        const auto expected = reference_atan2(y, x);
+        const auto actual = to_degrees(fixed_atan2(y, x));
+        // Inputs of a few counts are too coarse to hold the angle itself
+        const auto allowed = radius < 10.0 ? 0.5 : tolerance;
+        worst_error = std::max(worst_error,
+                               angle_error(actual, expected) * tolerance /
+                                 allowed);
+      }
+    }
+
+    // Verify
+    expect(le(worst_error, tolerance)) << worst_error;
+    expect(eq(0, fixed_atan2(0, 0)));
+  };
+
+  "tilt() matches double precision reference"_test = []() {
+    // Setup
+    constexpr double tolerance = 0.02;
+    double worst_pitch_error = 0.0;
+    double worst_roll_error = 0.0;
+
+    // Exercise
+    for (int pitch = -90; pitch <= 90; pitch += 5) {
+      for (int roll = -175; roll <= 180; roll += 5) {
+        const double theta = pitch * std::numbers::pi / 180.0;
+        const double phi = roll * std::numbers::pi / 180.0;
+        const raw_acceleration sample{
+          .x = to_counts(-std::sin(theta)),
+          .y = to_counts(std::cos(theta) * std::sin(phi)),
+          .z = to_counts(std::cos(theta) * std::cos(phi)),
+        };
+        const auto result = tilt(sample);
+
+        const double expected_pitch = reference_atan2(
+          -sample.x, std::hypot<double>(sample.y, sample.z));
+        worst_pitch_error =
+          std::max(worst_pitch_error,
+                   angle_error(to_degrees(result.pitch), expected_pitch));
+
+        // roll is undefined when looking straight up or down
+        if (std::abs(pitch) != 90) {
+          const double expected_roll = reference_atan2(sample.y, sample.z);
+          worst_roll_error =
+            std::max(worst_roll_error,
+                     angle_error(to_degrees(result.roll), expected_roll));
+        }
+      }
+    }
+
+    // Verify
+    expect(le(worst_pitch_error, tolerance)) << worst_pitch_error;
+    expect(le(worst_roll_error, tolerance)) << worst_roll_error;
+  };
+
+  "complementary_filter::update() follows gyroscope and removes drift"_test =
+    []() {
+      // Setup
+      complementary_filter filter({});
+      const raw_acceleration level{ .x = 0, .y = 0, .z = 16384 };
+      // 131 counts is 1°/s at ±250°/s
+      const raw_rotation spinning{ .x = 131 * 90 };
+      const raw_rotation still{};
+      constexpr std::uint32_t period_us = 1000;
+
+      // Exercise
+      filter.update(level, still, period_us);
+      auto spun = filter.update(level, spinning, period_us);
+      tilt_t settled{};
+      for (int i = 0; i < 500; i++) {
+        settled = filter.update(level, still, period_us);
+      }
+
+      // Verify
+      // 90°/s for 1ms moves 0.09°, of which 98% is kept. The tolerance covers
+      // the residual of the last CORDIC iteration.
+      constexpr double tolerance = 0.005;
+      expect(lt(std::abs(to_degrees(spun.roll) - 0.0882), tolerance))
+        << to_degrees(spun.roll);
+      expect(lt(std::abs(to_degrees(settled.roll)), tolerance))
+        << to_degrees(settled.roll);
+      expect(lt(std::abs(to_degrees(settled.pitch)), tolerance))
+        << to_degrees(settled.pitch);
+    };
+};
+}  // namespace hal::mpu
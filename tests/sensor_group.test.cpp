@@ -0,0 +1,119 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <array>
+#include <cstdint>
+
+#include <boost/ut.hpp>
+#include <libhal-mpu/lis3dhtr.hpp>
+#include <libhal-mpu/mpu6050.hpp>
+#include <libhal-mpu/sensor_group.hpp>
+
+#include "mock_register_i2c.hpp"
+
+namespace hal::mpu {
+namespace {
+raw_acceleration sample(std::int16_t p_x,
+                        std::int16_t p_y,
+                        std::int16_t p_z,
+                        hal::byte p_gscale = 0)
+{
+  return { .x = p_x, .y = p_y, .z = p_z, .gscale = p_gscale };
+}
+}  // namespace
+
+void sensor_group_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  "sensor_group::read() reads every sensor back to back"_test = []() {
+    // Setup
+    mock_register_i2c bus;
+    bus.registers[0x75] = 0x68;
+    mock_register_i2c lis_bus;
+    lis_bus.registers[0x0F] = 0x33;
+    mpu6050 primary(bus, mpu6050::address_ground);
+    mpu6050 secondary(bus, mpu6050::address_voltage_high);
+    lis3dhtr lis(lis_bus);
+    lis.configure_full_scale(lis3dhtr::max_acceleration::g4);
+    // MPU: Z = 16384, high byte first
+    bus.registers[0x3F] = 0x40;
+    // LIS: Z = 8192, low byte first
+    lis_bus.registers[0x2D] = 0x20;
+    sensor_group group(primary, secondary, lis);
+    const auto transactions = bus.transactions + lis_bus.transactions;
+
+    // Exercise
+    auto frame = group.read();
+
+    // Verify
+    static_assert(decltype(group)::size == 3);
+    expect(eq(transactions + 3, bus.transactions + lis_bus.transactions));
+    expect(eq(16384, frame[0].z));
+    expect(eq(16384, frame[1].z));
+    expect(eq(8192, frame[2].z));
+    expect(eq(hal::byte{ 1 }, frame[2].gscale));
+  };
+
+  "average() brings samples to a common scale"_test = []() {
+    // Setup
+    const std::array frame{ sample(100, -100, 16384),
+                            sample(51, -51, 8192, 1),
+                            sample(0, 0, 16385) };
+
+    // Exercise
+    auto mean = average(frame);
+
+    // Verify
+    // Means of 100, 102 and 0, of -100, -102 and 0 and of 16384, 16384 and
+    // 16385 at ±2g, halved for ±4g
+    expect(eq(hal::byte{ 1 }, mean.gscale));
+    expect(eq(34, mean.x));
+    expect(eq(-34, mean.y));
+    expect(eq(8192, mean.z));
+  };
+
+  "median() rejects a faulty sensor"_test = []() {
+    // Setup
+    const std::array frame{ sample(10, 20, 16380),
+                            sample(-32768, 32767, 0),
+                            sample(14, 24, 16390) };
+    const std::array pair{ sample(10, -10, 16000),
+                           sample(13, -13, 16001) };
+
+    // Exercise
+    auto voted = median(frame);
+    auto paired = median(pair);
+
+    // Verify
+    expect(eq(10, voted.x));
+    expect(eq(24, voted.y));
+    expect(eq(16380, voted.z));
+    // Two sensors average the middle values, rounding away from zero
+    expect(eq(12, paired.x));
+    expect(eq(-12, paired.y));
+    expect(eq(16001, paired.z));
+  };
+
+  "spread()"_test = []() {
+    // Setup
+    const std::array agree{ sample(10, 20, 16380), sample(6, 12, 8190, 1) };
+    const std::array loose{ sample(0, 0, 16384), sample(0, 0, 0) };
+
+    // Exercise + Verify
+    expect(eq(4, spread(agree)));
+    expect(eq(16384, spread(loose)));
+  };
+};
+}  // namespace hal::mpu
@@ -0,0 +1,168 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/ut.hpp>
+#include <libhal-mpu/mpu6050.hpp>
+#include <libhal-mpu/temperature_compensation.hpp>
+#include <libhal/error.hpp>
+
+#include "mock_register_i2c.hpp"
+
+namespace hal::mpu {
+namespace {
+constexpr hal::byte who_am_i = 0x75;
+constexpr hal::byte accel_xout_h = 0x3B;
+
+fixed_celsius celsius(double p_degrees)
+{
+  return static_cast<fixed_celsius>(std::lround(p_degrees * 65536.0));
+}
+
+thermal_sample at(double p_degrees, std::int16_t p_z, hal::byte p_gscale = 0)
+{
+  thermal_sample sample{};
+  sample.acceleration.z = p_z;
+  sample.acceleration.gscale = p_gscale;
+  sample.temperature = celsius(p_degrees);
+  return sample;
+}
+}  // namespace
+
+void temperature_compensation_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  "mpu6050::to_celsius()"_test = []() {
+    // Setup
+    static_assert(mpu6050::to_celsius(0) == 2394030);
+    static_assert(mpu6500::to_celsius(0) == 21 * fixed_celsius_degree);
+
+    // Exercise
+    auto warm = mpu6050::to_celsius(-521);
+    auto cold = mpu6500::to_celsius(-8000);
+
+    // Verify
+    // Within a quarter of a TEMP_OUT count
+    expect(std::abs(warm - celsius(-521 / 340.0 + 36.53)) < 50) << warm;
+    expect(std::abs(cold - celsius(-8000 / 333.87 + 21.0)) < 50) << cold;
+  };
+
+  "mpu6050::read_raw_with_temperature() is one transaction"_test = []() {
+    // Setup
+    mock_register_i2c device;
+    device.registers[who_am_i] = 0x68;
+    mpu6050 mpu(device);
+    // X = 1, Y = -1, Z = 16384, TEMP_OUT = -521
+    const std::array<hal::byte, 8> output{ 0x00, 0x01, 0xFF, 0xFF,
+                                           0x40, 0x00, 0xFD, 0xF7 };
+    std::copy(
+      output.begin(), output.end(), device.registers.begin() + accel_xout_h);
+    const auto transactions = device.transactions;
+
+    // Exercise
+    auto sample = mpu.read_raw_with_temperature();
+
+    // Verify
+    expect(eq(transactions + 1, device.transactions));
+    expect(eq(1, sample.acceleration.x));
+    expect(eq(-1, sample.acceleration.y));
+    expect(eq(16384, sample.acceleration.z));
+    expect(eq(mpu6050::to_celsius(-521), sample.temperature));
+  };
+
+  "temperature_compensation::apply()"_test = []() {
+    // Setup
+    temperature_model model;
+    model.axes[2].offset = 100;
+    model.axes[2].linear = 10 * fixed_celsius_degree;
+    model.axes[2].quadratic = fixed_celsius_degree;
+    temperature_compensation compensation(model);
+
+    // Exercise
+    // 100 + 10 * 10 + 1 * 10² counts at ±2g
+    auto hot = compensation.apply(at(35.0, 16684));
+    // Half as many counts at ±4g
+    auto hot_4g = compensation.apply(at(35.0, 8342, 1));
+    // 100 - 10 * 10 + 1 * 10²
+    auto cold = compensation.apply(at(15.0, 16484));
+    auto saturated = compensation.apply(at(25.0, -32768));
+
+    // Verify
+    expect(eq(16384, hot.z));
+    expect(eq(8192, hot_4g.z));
+    expect(eq(hal::byte{ 1 }, hot_4g.gscale));
+    expect(eq(16384, cold.z));
+    expect(eq(-32768, saturated.z));
+  };
+
+  "fit_temperature_model() recovers the bias"_test = []() {
+    // Setup
+    std::vector<thermal_sample> samples;
+    for (int step = 0; step <= 80; step++) {
+      const double degrees = -10.0 + step;
+      const double delta = degrees - 25.0;
+      thermal_sample sample{};
+      sample.temperature = celsius(degrees);
+      sample.acceleration.x = static_cast<std::int16_t>(
+        std::lround(50.0 + 3.5 * delta + 0.02 * delta * delta));
+      sample.acceleration.z =
+        static_cast<std::int16_t>(std::lround(16384.0 - 20.0 - 1.25 * delta));
+      samples.push_back(sample);
+    }
+    raw_acceleration flat{};
+    flat.z = 16384;
+
+    // Exercise
+    auto quadratic =
+      fit_temperature_model(samples, flat, temperature_fit::quadratic);
+    auto linear = fit_temperature_model(samples, flat, temperature_fit::linear);
+    temperature_compensation compensation(quadratic);
+    auto corrected = compensation.apply(samples.front());
+
+    // Verify
+    const auto& x = quadratic.axes[0];
+    const auto& z = linear.axes[2];
+    expect(std::abs(x.offset - 50) <= 1) << x.offset;
+    expect(std::abs(x.linear - celsius(3.5)) < celsius(0.02)) << x.linear;
+    expect(std::abs(x.quadratic - celsius(0.02)) < celsius(0.002))
+      << x.quadratic;
+    expect(std::abs(z.offset + 20) <= 1) << z.offset;
+    expect(std::abs(z.linear - celsius(-1.25)) < celsius(0.02)) << z.linear;
+    expect(std::abs(corrected.x) <= 1) << corrected.x;
+    expect(std::abs(corrected.z - 16384) <= 1) << corrected.z;
+  };
+
+  "fit_temperature_model() needs enough temperatures"_test = []() {
+    // Setup
+    const std::array<thermal_sample, 3> samples{
+      at(20.0, 16384), at(20.0, 16390), at(30.0, 16400)
+    };
+    raw_acceleration flat{};
+    flat.z = 16384;
+
+    // Exercise + Verify
+    expect(throws<hal::argument_out_of_domain>([&]() {
+      fit_temperature_model(samples, flat, temperature_fit::quadratic);
+    }));
+    expect(not throws<hal::argument_out_of_domain>([&]() {
+      fit_temperature_model(samples, flat, temperature_fit::linear);
+    }));
+  };
+};
+}  // namespace hal::mpu
@@ -0,0 +1,149 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <cmath>
+#include <numbers>
+
+#include <boost/ut.hpp>
+#include <libhal-mpu/mpu6050.hpp>
+#include <libhal-mpu/vibration_spectrum.hpp>
+
+#include "mock_register_i2c.hpp"
+
+namespace hal::mpu {
+namespace {
+constexpr float sample_rate = 1000.0f;
+
+/// Counts for an acceleration in g at the ±2g full scale
+std::int16_t to_counts(double p_g)
+{
+  return static_cast<std::int16_t>(std::lround(p_g * 16384.0));
+}
+
+double sine(double p_amplitude, double p_frequency, std::size_t p_index)
+{
+  return p_amplitude * std::sin(2.0 * std::numbers::pi * p_frequency *
+                                static_cast<double>(p_index) / sample_rate);
+}
+
+bool near(float p_actual, float p_expected, float p_tolerance)
+{
+  return std::abs(p_actual - p_expected) <= p_tolerance;
+}
+}  // namespace
+
+void vibration_spectrum_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  using spectrum_t = vibration_spectrum<256, 3>;
+  const spectrum_t::settings settings{
+    .sample_rate = sample_rate,
+    .band_edges = { 10.0f, 100.0f, 200.0f, 500.0f },
+  };
+
+  "vibration_spectrum::analyze() on a bin centered sine"_test = [&]() {
+    // Setup
+    spectrum_t spectrum(settings);
+    std::array<raw_acceleration, 256> samples{};
+    for (std::size_t i = 0; i < samples.size(); i++) {
+      // 125Hz lands exactly on bin 32, on top of 1g of gravity
+      samples[i].x = to_counts(1.0 + sine(0.5, 125.0, i));
+    }
+
+    // Exercise
+    auto features = spectrum.analyze(samples, axis::x);
+
+    // Verify
+    expect(near(features.rms, 0.5f / std::numbers::sqrt2_v<float>, 0.001f))
+      << features.rms;
+    expect(near(features.peak_frequency, 125.0f, 0.01f))
+      << features.peak_frequency;
+    expect(near(features.peak_amplitude, 0.5f, 0.005f))
+      << features.peak_amplitude;
+    expect(near(features.band_energy[0], 0.0f, 0.0001f));
+    expect(near(features.band_energy[1], 0.125f, 0.001f))
+      << features.band_energy[1];
+    expect(near(features.band_energy[2], 0.0f, 0.0001f));
+  };
+
+  "vibration_spectrum::analyze() interpolates between bins"_test = [&]() {
+    // Setup
+    spectrum_t spectrum(settings);
+    std::array<raw_acceleration, 256> samples{};
+    for (std::size_t i = 0; i < samples.size(); i++) {
+      samples[i].gscale = 1;
+      // At ±4g each count is twice as large
+      samples[i].z = to_counts((sine(1.0, 312.7, i) + sine(0.2, 40.0, i)) / 2);
+    }
+
+    // Exercise
+    auto features = spectrum.analyze(samples, axis::z);
+
+    // Verify
+    const auto bin_width = sample_rate / 256.0f;
+    expect(near(features.peak_frequency, 312.7f, bin_width / 4.0f))
+      << features.peak_frequency;
+    expect(near(features.rms, std::sqrt(0.5f + 0.02f), 0.01f)) << features.rms;
+    expect(near(features.band_energy[0], 0.02f, 0.002f))
+      << features.band_energy[0];
+    expect(near(features.band_energy[2], 0.5f, 0.01f))
+      << features.band_energy[2];
+  };
+
+  "vibration_spectrum::analyze() on a FIFO burst from an mpu6050"_test =
+    [&]() {
+      // Setup
+      constexpr hal::byte fifo_count_high = 0x72;
+      constexpr hal::byte fifo_data = 0x74;
+      constexpr std::size_t block = 256;
+      mock_register_i2c device;
+      device.registers[0x75] = 0x68;
+      device.stream_register = fifo_data;
+      for (std::size_t i = 0; i < block; i++) {
+        const auto z = to_counts(1.0 + sine(0.25, 62.5, i));
+        for (const auto axis : { std::int16_t{ 0 }, std::int16_t{ 0 }, z }) {
+          const auto value = static_cast<std::uint16_t>(axis);
+          device.stream.push_back(static_cast<hal::byte>(value >> 8));
+          device.stream.push_back(static_cast<hal::byte>(value & 0xFF));
+        }
+      }
+      // The FIFO holds 170 samples, so the block is drained in two halves
+      constexpr std::size_t burst = block / 2;
+      static_assert(burst <= mpu6050::fifo_capacity);
+      constexpr std::size_t fifo_bytes = burst * 6;
+      device.registers[fifo_count_high] = fifo_bytes >> 8;
+      device.registers[fifo_count_high + 1] = fifo_bytes & 0xFF;
+      mpu6050 mpu(device);
+      spectrum_t spectrum(settings);
+      std::array<raw_acceleration, block> samples{};
+
+      // Exercise
+      mpu.enable_fifo();
+      auto first = mpu.read_fifo(std::span(samples).first(burst));
+      auto second = mpu.read_fifo(std::span(samples).subspan(burst));
+      auto features = spectrum.analyze(samples, axis::z);
+
+      // Verify
+      expect(eq(burst, first.size()));
+      expect(eq(burst, second.size()));
+      expect(near(features.peak_frequency, 62.5f, 0.01f))
+        << features.peak_frequency;
+      expect(near(features.peak_amplitude, 0.25f, 0.005f))
+        << features.peak_amplitude;
+      expect(near(features.band_energy[0], 0.03125f, 0.001f))
+        << features.band_energy[0];
+    };
+};
+}  // namespace hal::mpu
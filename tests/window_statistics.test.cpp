@@ -0,0 +1,221 @@
+// Copyright 2024 Khalil Estell
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <boost/ut.hpp>
+#include <libhal-mpu/window_statistics.hpp>
+
+namespace hal::mpu {
+namespace {
+bool near(float p_actual, float p_expected, float p_tolerance)
+{
+  return std::abs(p_actual - p_expected) <= p_tolerance;
+}
+
+raw_acceleration sample(std::int16_t p_x, hal::byte p_gscale = 0)
+{
+  raw_acceleration result{};
+  result.x = p_x;
+  result.gscale = p_gscale;
+  return result;
+}
+}  // namespace
+
+void window_statistics_test()
+{
+  using namespace boost::ut;
+  using namespace std::literals;
+
+  "window_statistics<tumbling>::add() closes every window"_test = []() {
+    // Setup
+    window_statistics<4> statistics;
+    // 0.5g, -0.25g, 1g, 0.75g at ±2g
+    const std::array<std::int16_t, 4> counts{ 8192, -4096, 16384, 12288 };
+
+    // Exercise
+    std::array<bool, 4> closed{};
+    for (std::size_t i = 0; i < counts.size(); i++) {
+      closed[i] = statistics.add(sample(counts[i]));
+    }
+    auto result = statistics.statistics();
+
+    // Verify
+    expect(not closed[0]);
+    expect(not closed[1]);
+    expect(not closed[2]);
+    expect(closed[3]);
+    expect(near(result.x.min, -0.25f, 0.0001f)) << result.x.min;
+    expect(near(result.x.max, 1.0f, 0.0001f)) << result.x.max;
+    expect(near(result.x.mean, 0.5f, 0.0001f)) << result.x.mean;
+    // mean of squares is (0.25 + 0.0625 + 1 + 0.5625) / 4 = 0.46875
+    expect(near(result.x.rms, std::sqrt(0.46875f), 0.0001f)) << result.x.rms;
+    expect(near(result.x.variance, 0.46875f - 0.25f, 0.0001f))
+      << result.x.variance;
+    expect(near(result.y.rms, 0.0f, 0.0001f));
+  };
+
+  "window_statistics<tumbling> starts each window afresh"_test = []() {
+    // Setup
+    window_statistics<2> statistics;
+    statistics.add(sample(16384));
+    statistics.add(sample(16384));
+
+    // Exercise
+    statistics.add(sample(-8192));
+    statistics.add(sample(-8192));
+    auto result = statistics.statistics();
+
+    // Verify
+    expect(near(result.x.max, -0.5f, 0.0001f)) << result.x.max;
+    expect(near(result.x.mean, -0.5f, 0.0001f)) << result.x.mean;
+    expect(near(result.x.variance, 0.0f, 0.0001f)) << result.x.variance;
+  };
+
+  "window_statistics mixes samples of different full scales"_test = []() {
+    // Setup
+    window_statistics<2> statistics;
+
+    // Exercise
+    // 1g at ±2g and 2g at ±16g
+    statistics.add(sample(16384, 0));
+    statistics.add(sample(4096, 3));
+    auto result = statistics.statistics();
+
+    // Verify
+    expect(near(result.x.min, 1.0f, 0.0001f)) << result.x.min;
+    expect(near(result.x.max, 2.0f, 0.0001f)) << result.x.max;
+    expect(near(result.x.mean, 1.5f, 0.0001f)) << result.x.mean;
+  };
+
+  "window_statistics<sliding> matches a full recomputation"_test = []() {
+    // Setup
+    constexpr std::size_t window = 7;
+    window_statistics<window, window_kind::sliding> statistics;
+    std::vector<std::int16_t> history;
+    std::uint32_t state = 12345;
+    bool matched = true;
+
+    // Exercise
+    for (std::size_t i = 0; i < 200; i++) {
+      // Small linear congruential generator for repeatable noise
+      state = state * 1103515245u + 12345u;
+      const auto counts = static_cast<std::int16_t>((state >> 16) & 0x7FFF);
+      history.push_back(static_cast<std::int16_t>(counts - 16384));
+      const bool closed = statistics.add(sample(history.back()));
+
+      if (closed != (history.size() >= window)) {
+        matched = false;
+      }
+      if (!closed) {
+        continue;
+      }
+
+      const auto first = history.end() - window;
+      const auto [low, high] = std::minmax_element(first, history.end());
+      double sum = 0.0;
+      for (auto it = first; it != history.end(); it++) {
+        sum += *it / 16384.0;
+      }
+      double spread = 0.0;
+      for (auto it = first; it != history.end(); it++) {
+        const auto centered = *it / 16384.0 - sum / window;
+        spread += centered * centered;
+      }
+
+      const auto result = statistics.statistics();
+      const auto mean = static_cast<float>(sum / window);
+      const auto variance = static_cast<float>(spread / window);
+      matched = matched && near(result.x.min, *low / 16384.0f, 0.0001f) &&
+                near(result.x.max, *high / 16384.0f, 0.0001f) &&
+                near(result.x.mean, mean, 0.0001f) &&
+                near(result.x.variance, variance, 0.0001f);
+    }
+
+    // Verify
+    expect(matched);
+  };
+
+  "window_statistics<sliding>::statistics() is empty until filled"_test =
+    []() {
+      // Setup
+      window_statistics<3, window_kind::sliding> statistics;
+
+      // Exercise
+      statistics.add(sample(16384));
+      statistics.add(sample(16384));
+      const auto partial = statistics.statistics();
+      statistics.add(sample(16384));
+      statistics.reset();
+      const auto after_reset = statistics.statistics();
+      statistics.add(sample(-16384));
+      statistics.add(sample(-16384));
+      const bool closed = statistics.add(sample(-16384));
+
+      // Verify
+      expect(near(partial.x.mean, 0.0f, 0.0001f));
+      expect(near(partial.x.min, 0.0f, 0.0001f));
+      expect(near(after_reset.x.mean, 0.0f, 0.0001f));
+      expect(near(after_reset.x.max, 0.0f, 0.0001f));
+      expect(closed);
+      expect(near(statistics.statistics().x.max, -1.0f, 0.0001f));
+    };
+
+  "window_statistics<tumbling>::statistics() is empty until closed"_test =
+    []() {
+      // Setup
+      window_statistics<2> statistics;
+
+      // Exercise
+      const auto before_first = statistics.statistics();
+      statistics.add(sample(16384));
+      const auto partial = statistics.statistics();
+      statistics.add(sample(16384));
+      statistics.reset();
+      const auto after_reset = statistics.statistics();
+
+      // Verify
+      for (const auto& result : { before_first, partial, after_reset }) {
+        expect(near(result.x.min, 0.0f, 0.0001f));
+        expect(near(result.x.max, 0.0f, 0.0001f));
+        expect(near(result.z.min, 0.0f, 0.0001f));
+        expect(near(result.z.max, 0.0f, 0.0001f));
+        expect(near(result.z.variance, 0.0f, 0.0001f));
+      }
+    };
+
+  "window_statistics::add() on a batch reports each closed window"_test =
+    []() {
+      // Setup
+      window_statistics<4> statistics;
+      std::array<raw_acceleration, 10> samples{};
+      for (std::size_t i = 0; i < samples.size(); i++) {
+        samples[i].z = static_cast<std::int16_t>(i * 1024);
+      }
+      std::vector<float> means;
+
+      // Exercise
+      statistics.add(samples, [&means](const auto& p_statistics) {
+        means.push_back(p_statistics.z.mean);
+      });
+
+      // Verify
+      expect(eq(2u, means.size()));
+      // (0 + 1 + 2 + 3) / 4 and (4 + 5 + 6 + 7) / 4 sixteenths of a g
+      expect(near(means[0], 1.5f / 16.0f, 0.0001f)) << means[0];
+      expect(near(means[1], 5.5f / 16.0f, 0.0001f)) << means[1];
+    };
+};
+}  // namespace hal::mpu